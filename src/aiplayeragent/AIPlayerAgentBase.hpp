@@ -12,69 +12,24 @@
 #ifndef AIPLAYERAGENTBASE_HPP
 #define AIPLAYERAGENTBASE_HPP
 
-//#define USE_THREADS_FOR_AGENTS
-
-#ifdef USE_THREADS_FOR_AGENTS
-#include <condition_variable>
-#include <mutex>
-#include <thread>
-#endif // USE_THREADS_FOR_AGENTS
+#include <cstdint>
+#include <limits>
 
 #include "aiplayeragent/IAIPlayerAgent.hpp"
+#include "aiplayeragent/PlanBudget.hpp"
 #include "core/Common.hpp"
 
 class AIPlayerAgentBase : public IAIPlayerAgent {
 private:
-#ifdef USE_THREADS_FOR_AGENTS
-	// The thread in which the agent runs
-	std::thread m_thr;
-#endif // USE_THREADS_FOR_AGENTS
 	// Whether the `kill()` method has been called
-	bool m_isThreadFinished;
-
-#ifdef USE_THREADS_FOR_AGENTS
-	// True if the thread is currently inside the `doPlan()` method
-	bool m_isPlanning;
-	std::condition_variable m_cvIsPlanning;
-	std::mutex m_mutexIsPlanning;
-
-	// If false, the thread will be blocked at the beggining of its loop
-	bool m_isPlanNotify;
-	std::condition_variable m_cvIsPlanNotify;
-	std::mutex m_mutexIsPlanNotify;
-
-	/**
-	 * @brief The main function of the `m_t` thread.
-	 */
-	void threadMain();
-
-	/**
-	 * @brief (Passively) waits until a condition becomes true.
-	 * 
-	 * @tparam Predicate Must meet the requirements of `FunctionObject`
-	 *                   whose return value is convertible to `bool`.
-	 * @param m The mutex to lock.
-	 * @param cv The condition variable to wait at.
-	 * @param pred The condition to wait for it becoming true.
-	 */
-	template <typename Predicate>
-	void waitForCondition(std::mutex& m, std::condition_variable& cv,
-		Predicate pred);
-	/**
-	 * @brief Updates a condition value.
-	 * 
-	 * @tparam Predicate Must be callable.
-	 * @param m The mutex to lock.
-	 * @param cv The condition variable to notify.
-	 * @param pred Callable which modifies the condition state.
-	 */
-	template <typename Predicate>
-	void updateCondition(std::mutex& m, std::condition_variable& cv,
-		Predicate pred);
-#endif // USE_THREADS_FOR_AGENTS
+	bool m_isKilled;
 protected:
 	GameStateAgentProxyP gsProxy;
 	const PlayerId myId;
+	// Private random number engine of the agent
+	RNGineType rng;
+	// Budget of the current planning (started before `doPlan()`)
+	PlanBudget planBudget;
 
 	/**
 	 * @brief Returns player state which belongs to this agent.
@@ -87,9 +42,17 @@ protected:
 	 * @brief Performs planning.
 	 * 
 	 * @details In the worst case, the execution time should be `TICK_INTERVAL
-	 *          / MAX_PLAYERS` (17 / 8 ~ 2 ms).
+	 *          / MAX_PLAYERS` (17 / 8 ~ 2 ms). The searching agents should
+	 *          check `planBudget` to achieve that.
 	 */
 	virtual void doPlan() = 0;
+	/**
+	 * @brief Returns the number of work units a single planning may do if the
+	 *        plan budget is not time.
+	 */
+	virtual uint64_t getPlanWorkLimit() const {
+		return std::numeric_limits<uint64_t>::max();
+	}
 	/**
 	 * @brief Returns the desired agent input based on previous planning.
 	 */
@@ -100,30 +63,9 @@ public:
 	PlayerInputFlags getPlayerInput() override;
 	void plan() override;
 	void assignProxy(GameStateAgentProxyP value) override;
+	void seedRNG(RNGSeedType seed) override;
+	void setPlanBudget(double ms) override;
 	void kill() override;
 };
 
-#ifdef USE_THREADS_FOR_AGENTS
-
-template<typename Predicate>
-inline void AIPlayerAgentBase::waitForCondition(std::mutex& m,
-	std::condition_variable& cv, Predicate pred)
-{
-	std::unique_lock<std::mutex> lk(m);
-	cv.wait(lk, pred);
-}
-
-template<typename Predicate>
-inline void AIPlayerAgentBase::updateCondition(std::mutex& m,
-	std::condition_variable& cv, Predicate pred)
-{
-	{
-		std::lock_guard<std::mutex> lk(m);
-		pred();
-	}
-	cv.notify_all();
-}
-
-#endif // USE_THREADS_FOR_AGENTS
-
 #endif // AIPLAYERAGENTBASE_HPP
@@ -20,88 +20,104 @@ PlayerInputFlags AstarPredatorAIPlayerAgent::chooseNextAction(
 	AutoLogger_Measure measureLogger(BENCH_ID);
 #endif // DO_LOG_ASTAR_PREDATOR
 
-	auto d = astarDataCreate(victim);
-	astarDataInit(d);
+	const auto& me = getMyState();
+	const auto& grid = gsProxy->getStageGridModel();
+	auto sStart = grid.getCellIndexAt(me.pos);
+	auto sGoal = grid.getCellIndexAt(victim->pos);
+	auto& d = m_search;
+
+	// Already in goal?
+	if (sStart == sGoal) {
+		d.isActive = false;
+		return PlayerInputFlags();
+	}
+
+	if (!isAstarResumable(d, sStart, sGoal)) {
+		astarDataInit(d, sStart, sGoal);
+#ifdef DO_LOG_ASTAR_PREDATOR
+		sqdistLogger.incNodeCount(); // Initial node
+#endif // DO_LOG_ASTAR_PREDATOR
+	}
 
 #ifdef DO_LOG_ASTAR_PREDATOR
 	d.sqdistLogger = &sqdistLogger;
 	d.measureLogger = &measureLogger;
-	sqdistLogger.incNodeCount(); // Initial node
 #endif // DO_LOG_ASTAR_PREDATOR
 
-	// Already in goal?
-	if (d.sStart == d.sGoal) return PlayerInputFlags();
+	auto passability = grid.getPassability(d.mySqsize);
 
 #if ASTAR_PREDATOR_VERSION == 3
-	while (!d.isFinished) {
-		astarProcessNextNode(d);
+	while (!d.isFinished && !planBudget.isExhausted()) {
+		astarProcessNextNode(d, passability);
 	}
+
+	// If the search has been suspended, the top of OPEN has not been
+	// considered yet
+	astarRefreshNearestNode(d);
 #else // ASTAR_PREDATOR_VERSION != 3
-	while (!d.astarOpen.empty()) {
-		astarProcessNextNode(d);
+	while (!d.astarOpen.empty() && !planBudget.isExhausted()) {
+		astarProcessNextNode(d, passability);
 		if (d.isFinished) {
 			break;
 		}
 	}
+
+	if (d.astarOpen.empty()) return PlayerInputFlags();
 #endif // ASTAR_PREDATOR_VERSION != 3
 
-	return d.bestInput;
+	return astarGetBestInput(d, me);
 }
 
-AstarPredatorAIPlayerAgent::AstarData AstarPredatorAIPlayerAgent::astarDataCreate(
-	const GameStateAgentProxy::PlayerState* victim) const
+bool AstarPredatorAIPlayerAgent::isAstarResumable(const AstarData& d,
+	CellIndex sStart, CellIndex sGoal) const
 {
-	const auto& me = getMyState();
-	const auto& grid = gsProxy->getStageGridModel();
-	auto sStart = grid.getCellAt(me.pos);
-	auto sGoal = grid.getCellAt(victim->pos);
-
-	AstarData res = {
-		me,                 // me
-		victim,             // victim
-		grid,               // grid
-		sqr(me.size),       // mySqsize
+	// The nodes the bubble does not fit into depend on its size
+	return d.isActive && (d.sStart == sStart) && (d.sGoal == sGoal)
+		&& (d.mySqsize == sqr(getMyState().size));
+}
 
-		sStart,             // sStart
-		sGoal,              // sGoal
+void AstarPredatorAIPlayerAgent::astarDataInit(AstarData& d, CellIndex sStart,
+	CellIndex sGoal) const
+{
+	const auto& grid = gsProxy->getStageGridModel();
 
-		AstarOpen(),        // astarOpen
-		AstarClosed(),      // astarClosed
+	d.mySqsize = sqr(getMyState().size);
+	d.sStart = sStart;
+	d.sGoal = sGoal;
 
-		1,                  // generatedNodes
+	d.astarOpen.clear();
+	if (d.astarOpen.getItemCount() != grid.getCellCount()) {
+		d.astarOpen.resize(grid.getCellCount());
+		d.cellNodes.resize(grid.getCellCount());
+	}
+	d.cellNodes.clear();
+	d.nodes.reset();
 
-		false,              // isFinished
-		PlayerInputFlags(), // bestInput
+	// Space is less of a problem than performance
+	d.astarOpen.reserve(PLAN_WORK_LIMIT);
+	d.nodes.reserve(PLAN_WORK_LIMIT);
 
+	d.generatedNodes = 1;
+	d.isActive = true;
+	d.isFinished = false;
 #if ASTAR_PREDATOR_VERSION == 3
-		nullptr,            // nearestNode
+	d.nearestNode = AstarArena::NO_NODE;
 #endif // ASTAR_PREDATOR_VERSION == 3
-#ifdef DO_LOG_ASTAR_PREDATOR
-		nullptr,            // sqdistLogger
-		nullptr,            // measureLogger
-#endif // DO_LOG_ASTAR_PREDATOR
-	};
-	return res;
-}
 
-void AstarPredatorAIPlayerAgent::astarDataInit(AstarData& d) const
-{
-	// Space is less of a problem than performance
-	d.astarOpen.reserve(d.MAX_GENERATED_NODES);
-	d.astarClosed.reserve(d.MAX_GENERATED_NODES);
-
-	auto initialHvalue = getHvalue(d.sStart, d.sGoal);
+	auto initialHvalue = getHvalue(grid, sStart, sGoal);
 	// Initial node
-	auto astarStart = std::make_shared<AstarNode>(AstarNode{
-		d.sStart,      // cell
+	auto astarStart = d.nodes.add(AstarNode{
+		sStart,        // cell
 		DIR8_NONE,     // direction
 		0,             // gvalue
 		initialHvalue, // hvalue
 	});
-	d.astarOpen.push(astarStart);
+	d.cellNodes.set(sStart, astarStart);
+	d.astarOpen.push(sStart, d.nodes[astarStart].fvalue());
 }
 
-void AstarPredatorAIPlayerAgent::astarProcessNextNode(AstarData& d) const
+void AstarPredatorAIPlayerAgent::astarProcessNextNode(AstarData& d,
+	const StageGridModel::Passability& passability)
 {
 #if ASTAR_PREDATOR_VERSION == 3
 	astarRefreshNearestNode(d);
@@ -109,46 +125,64 @@ void AstarPredatorAIPlayerAgent::astarProcessNextNode(AstarData& d) const
 
 	if (isAstarFinished(d)) {
 		d.isFinished = true;
-		d.bestInput = astarGetBestInput(d);
 	} else {
 		// Not finished; move the node from OPEN to CLOSED and expand it
-		
+		// (the cells which are generated and not in OPEN are CLOSED)
+
 		// The "next" node
-		// MUST NOT be reference; the value will be "popped", invalidating the
-		// reference.
-		auto n = d.astarOpen.top();
+		auto n = d.cellNodes.get(d.astarOpen.top());
 		d.astarOpen.pop(); // Pops `n`
-		d.astarClosed.insert(n);
 
-		astarExpandNode(d, n);
+		astarExpandNode(d, n, passability);
 	}
 }
 
 void AstarPredatorAIPlayerAgent::astarExpandNode(AstarData& d,
-	const AstarNodeP& n) const
+	AstarNodeIdx n, const StageGridModel::Passability& passability)
 {
+	const auto& grid = gsProxy->getStageGridModel();
+	auto nCell = d.nodes[n].cell;
+	// The neighbors which exist and the ones the bubble fits into
+	auto neighbors = grid.getNeighborMask(nCell);
+	auto fitNeighbors = passability.getNeighborMask(nCell);
+
 	// Try all actions
 	for (auto astarAction : ASTAR_ACTIONS) {
-		if (n->cell.hasNeighbor(astarAction)) {
+		auto actionBit = StageGridModel::getDirectionBit(astarAction);
+		if (neighbors & actionBit) {
 			// The action is legal in this state
 
-			auto astarSucc = getSucc(n, astarAction, d.sGoal);
+			auto s = grid.getNeighbor(nCell, astarAction);
 			d.generatedNodes++;
+			planBudget.spend();
 
 #ifdef DO_LOG_ASTAR_PREDATOR
 			d.sqdistLogger->incNodeCount();
 #endif // DO_LOG_ASTAR_PREDATOR
 
-			if (astarSucc->cell.getNearestObstacleDistance() > d.mySqsize) {
+			if (fitNeighbors & actionBit) {
 				// The node can be reached by the agent's bubble
 
-				if (!d.astarOpen.contains(astarSucc)
-					&& !d.astarClosed.contains(astarSucc))
-				{
+				// NOT a reference; adding to the arena may invalidate it
+				auto astarSucc = getSucc(grid, d.nodes[n], s, astarAction,
+					d.sGoal);
+
+				if (!d.cellNodes.contains(s)) {
 					// Brand new node
 
 					// Insert it to OPEN
-					d.astarOpen.push(astarSucc);
+					auto succIdx = d.nodes.add(astarSucc);
+					d.cellNodes.set(s, succIdx);
+					d.astarOpen.push(s, astarSucc.fvalue());
+				} else if (d.astarOpen.contains(s)) {
+					auto& node = d.nodes[d.cellNodes.get(s)];
+					if (astarSucc.gvalue < node.gvalue) {
+						// Found a shorter path to a node in OPEN
+
+						node.gvalue = astarSucc.gvalue;
+						node.direction = astarSucc.direction;
+						d.astarOpen.decreaseKey(s, node.fvalue());
+					}
 				}
 			}
 
@@ -161,33 +195,35 @@ void AstarPredatorAIPlayerAgent::astarExpandNode(AstarData& d,
 
 bool AstarPredatorAIPlayerAgent::isAstarFinished(AstarData& d) const
 {
-	// Node at the top of the OPEN
-	const auto& n = d.astarOpen.top();
-	return (d.generatedNodes >= d.MAX_GENERATED_NODES) || (n->cell == d.sGoal)
 #if ASTAR_PREDATOR_VERSION == 3
-		|| (d.astarOpen.empty())
+	if (d.astarOpen.empty()) return true;
 #endif // ASTAR_PREDATOR_VERSION == 3
-	;
+
+	// Cell at the top of the OPEN
+	auto n = d.astarOpen.top();
+	return (d.generatedNodes >= d.MAX_GENERATED_NODES) || (n == d.sGoal);
 }
 
 PlayerInputFlags AstarPredatorAIPlayerAgent::astarGetBestInput(
-	AstarData& d) const
+	AstarData& d, const GameStateAgentProxy::PlayerState& me) const
 {
 #if ASTAR_PREDATOR_VERSION == 1
-	return PlayerInputFlags(d.astarOpen.top()->direction);
+	(void)me;
+	return PlayerInputFlags(astarGetOpenTop(d).direction);
 #elif ASTAR_PREDATOR_VERSION >= 2
 #	if ASTAR_PREDATOR_VERSION == 2
 	// Node at the top of the OPEN
-	const auto& n = d.astarOpen.top();
+	const auto& n = astarGetOpenTop(d);
 #	elif ASTAR_PREDATOR_VERSION == 3
-	const auto& n = d.nearestNode;
+	const auto& n = d.nodes[d.nearestNode];
 #	endif // ASTAR_PREDATOR_VERSION == 3
 	// The direction taken in the root node to reach `n`
-	auto dir = n->direction;
+	auto dir = n.direction;
 	// Neighbor of the root cell in the `dir` direction
-	auto sStartNeigh = d.sStart.getNeighbor(dir);
+	const auto& grid = gsProxy->getStageGridModel();
+	auto sStartNeigh = grid.getNeighbor(d.sStart, dir);
 	// Position of the neighbor (i.e., the cell's center)
-	auto destPos = sStartNeigh.getPosition();
+	auto destPos = grid.getPosition(sStartNeigh);
 
 	auto bestInput = PlayerInputFlags();
 	auto bestSqdist = std::numeric_limits<double>::infinity();
@@ -195,7 +231,7 @@ PlayerInputFlags AstarPredatorAIPlayerAgent::astarGetBestInput(
 	// Try out all inputs and see which one brings the bubble closest to the
 	// neighbor node
 	for (auto input : generateInputs()) {
-		auto pos = gsProxy->calculateNewPlayerPos(d.me.pos, input, d.me);
+		auto pos = gsProxy->calculateNewPlayerPos(me.pos, input, me);
 		auto sqdist = CGAL::squared_distance(pos, destPos);
 		if (sqdist < bestSqdist) {
 			bestInput = input;
@@ -211,42 +247,50 @@ void AstarPredatorAIPlayerAgent::astarRefreshNearestNode(AstarData& d) const
 {
 	if (d.astarOpen.empty()) return;
 
-	const auto& n = d.astarOpen.top();
-	if (d.nearestNode == nullptr || n->hvalue < d.nearestNode->hvalue) {
+	auto n = d.cellNodes.get(d.astarOpen.top());
+	if (d.nearestNode == AstarArena::NO_NODE
+		|| d.nodes[n].hvalue < d.nodes[d.nearestNode].hvalue)
+	{
 		d.nearestNode = n;
 	}
 }
 #endif // ASTAR_PREDATOR_VERSION == 3
 
+const AstarPredatorAIPlayerAgent::AstarNode&
+AstarPredatorAIPlayerAgent::astarGetOpenTop(const AstarData& d)
+{
+	return d.nodes[d.cellNodes.get(d.astarOpen.top())];
+}
+
 AstarPredatorAIPlayerAgent::NodeEval AstarPredatorAIPlayerAgent::getHvalue(
-	const StageGridModel::Cell& s, const StageGridModel::Cell& sGoal)
+	const StageGridModel& grid, CellIndex s, CellIndex sGoal)
 {
 	// Manhattan distance -- given we can only move in cardinal directions, the
 	// shortest distance between two locations is given by the sum of the
 	// absolute differences of their respective Cartesian coordinates.
-	return std::abs(sGoal.getPosition().x() - s.getPosition().x())
-		+  std::abs(sGoal.getPosition().y() - s.getPosition().y());
+	const auto& sPos = grid.getPosition(s);
+	const auto& sGoalPos = grid.getPosition(sGoal);
+	return std::abs(sGoalPos.x() - sPos.x())
+		+  std::abs(sGoalPos.y() - sPos.y());
 }
 
-AstarPredatorAIPlayerAgent::AstarNodeP AstarPredatorAIPlayerAgent::getSucc(
-	const AstarPredatorAIPlayerAgent::AstarNodeP& n, Direction8 direction,
-	const StageGridModel::Cell& sGoal)
+AstarPredatorAIPlayerAgent::AstarNode AstarPredatorAIPlayerAgent::getSucc(
+	const StageGridModel& grid,
+	const AstarPredatorAIPlayerAgent::AstarNode& n, CellIndex s,
+	Direction8 direction, CellIndex sGoal)
 {
-	// Successor state
-	auto s = n->cell.getNeighbor(direction);
 	// Successor's `direction` property -- if the current node's `direction` is
 	// "NONE", then the current node is the root node, so the successor's
 	// `direction` is given by its actual direction from the current node (which
 	// is the root). Otherwise, it just "inherits" the value from the current
 	// node (which is not the root).
-	auto nDirection = (n->direction != DIR8_NONE ? n->direction : direction);
+	auto nDirection = (n.direction != DIR8_NONE ? n.direction : direction);
 	// Successor's g() value
-	NodeEval nGvalue = n->gvalue + 1;
+	NodeEval nGvalue = n.gvalue + 1;
 	// Successor's h() value
-	NodeEval nHvalue = getHvalue(s, sGoal);
+	NodeEval nHvalue = getHvalue(grid, s, sGoal);
 
-	auto res = std::make_shared<AstarNode>(AstarNode{s, nDirection, nGvalue,
-		nHvalue});
+	AstarNode res{s, nDirection, nGvalue, nHvalue};
 	return res;
 }
 
@@ -266,4 +310,6 @@ void AstarPredatorAIPlayerAgent::doPlan()
 AstarPredatorAIPlayerAgent::AstarPredatorAIPlayerAgent(PlayerId playerId)
 	: AIPlayerAgentBase(playerId)
 	, PredatorAIPlayerAgentBase(playerId)
-{}
+{
+	m_search.isActive = false;
+}
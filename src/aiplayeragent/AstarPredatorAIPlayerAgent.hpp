@@ -28,16 +28,20 @@
 //  - version 3
 //    - Once the maximum number of nodes is generated, the node closest to the
 //      goal is selected as the goal.
+//
+// The search is suspended once the plan budget is exhausted. Until it is
+// resumed, the best node found so far is taken as the goal. The search is
+// resumed as long as the initial and the goal states do not change.
 #define ASTAR_PREDATOR_VERSION 3
 
-#include <memory>
-#include <queue>
-#include <unordered_set>
-#include <vector>
+#include <array>
 
 #include "playerinput/PlayerInputFlags.hpp"
 #include "aiplayeragent/PredatorAIPlayerAgentBase.hpp"
 #include "aiplayeragent/StageGridModel.hpp"
+#include "aiplayeragent/searchalgos/IndexedHeap.hpp"
+#include "aiplayeragent/searchalgos/NodeArena.hpp"
+#include "aiplayeragent/searchalgos/StampedArray.hpp"
 
 #ifdef INCLUDE_BENCHMARK
 #define DO_LOG_ASTAR_PREDATOR
@@ -53,12 +57,13 @@ class AstarPredatorAIPlayerAgent : public PredatorAIPlayerAgentBase {
 private:
 	typedef double NodeEval;
 	typedef std::array<Direction8, 4> AstarActions;
+	typedef StageGridModel::CellIndex CellIndex;
 	/**
 	 * @brief Node in the A* search tree.
 	 */
 	struct AstarNode {
 		// Cell corresponding to the node
-		StageGridModel::Cell cell;
+		CellIndex cell;
 		// The direction taken in the root node
 		Direction8 direction;
 		// g(s)
@@ -68,157 +73,51 @@ private:
 
 		NodeEval fvalue() const { return gvalue + hvalue; }
 	};
+	typedef NodeArena<AstarNode> AstarArena;
+	typedef AstarArena::NodeIdx AstarNodeIdx;
 	/**
-	 * @brief Node in the A* search tree.
-	 */
-	typedef std::shared_ptr<AstarNode> AstarNodeP;
-	/**
-	 * @brief Hash function object for the A* node.
-	 */
-	struct AstarNodeHash {
-		size_t operator()(const AstarNodeP& key) const {
-			return StageGridModel::Cell::Hash()(key->cell);
-		}
-	};
-	/**
-	 * @brief Equality comparison function object for the A* node.
+	 * @brief A* "OPEN priority queue" type (of cells, by f(s)).
 	 */
-	struct AstarNodeEqual {
-		bool operator()(const AstarNodeP& lhs, const AstarNodeP& rhs) const {
-			return (lhs->cell.getPosition() == rhs->cell.getPosition());
-		}
-	};
-	/**
-	 * @brief Priority comparison function object for the A* node.
-	 */
-	struct AstarNodeCompare {
-		bool operator()(const AstarNodeP& lhs, const AstarNodeP& rhs) const {
-			return (lhs->fvalue() > rhs->fvalue());
-		}
-	};
-	/**
-	 * @brief Priority queue for A* nodes.
-	 */
-	class AstarPrioq
-		: public std::priority_queue<AstarNodeP, std::vector<AstarNodeP>,
-		  AstarNodeCompare>
-	{
-	public:
-		/**
-		 * @brief Increases the capacity of the container to a value greater
-		 *        or equal to `n`.
-		 */
-		void reserve(size_t n) {
-			c.reserve(n);
-		}
-	};
-	/**
-	 * @brief Unordered set of A* nodes.
-	 */
-	typedef std::unordered_set<AstarNodeP, AstarNodeHash, AstarNodeEqual> AstarSet;
-	/**
-	 * @brief A* "OPEN priority queue" type.
-	 */
-	class AstarOpen {
-	private:
-		AstarPrioq m_prioq;
-		AstarSet m_set;
-	public:
-		/**
-		 * @brief Pushes the given element to the priority queue.
-		 */
-		void push(const AstarNodeP& x) {
-			m_prioq.push(x);
-			m_set.insert(x);
-		}
-		/**
-		 * @brief Removes the top element from the priority queue.
-		 */
-		void pop() {
-			m_set.erase(m_prioq.top());
-			m_prioq.pop();
-		}
-		/**
-		 * @brief Returns reference to the top element in the priority queue.
-		 */
-		const AstarNodeP& top() const {
-			return m_prioq.top();
-		}
-		/**
-		 * @brief Checks if the container contains the given element.
-		 */
-		bool contains(const AstarNodeP& x) const {
-			return (m_set.find(x) != m_set.end());
-		}
-		/**
-		 * @brief Returns the number of elements in the container.
-		 */
-		size_t size() const {
-			return m_prioq.size();
-		}
-		/**
-		 * @brief Checks whether the container is empty.
-		 */
-		bool empty() const {
-			return m_prioq.empty();
-		}
-		/**
-		 * @brief Increases the capacity of the container to a value greater
-		 *        or equal to `n`.
-		 */
-		void reserve(size_t n) {
-			m_prioq.reserve(n);
-			m_set.reserve(n);
-		}
-	};
+	typedef IndexedHeap<NodeEval> AstarOpen;
+
 	/**
-	 * @brief A* "CLOSED set" type.
+	 * @brief State of the A* search (kept between the plannings).
+	 * 
+	 * @details The containers are reused by the next search, so they do not
+	 *          allocate once they have grown large enough.
 	 */
-	class AstarClosed : public AstarSet {
-	public:
-		/**
-		 * @brief Checks if the container contains the given element.
-		 */
-		bool contains(const AstarNodeP& x) const {
-			return (find(x) != end());
-		}
-	};
-
 	struct AstarData {
-		// Quick access
-
-		// Player state which belongs to this agent
-		const GameStateAgentProxy::PlayerState& me;
-		// The player to chase after
-		const GameStateAgentProxy::PlayerState* victim;
-		const StageGridModel& grid;
 		// Square of "my" player radius
 		double mySqsize;
 
 		// Initial state
-		StageGridModel::Cell sStart;
+		CellIndex sStart;
 		// Goal state
-		StageGridModel::Cell sGoal;
-		
+		CellIndex sGoal;
+
+		// Nodes of the search tree
+		AstarArena nodes;
 		// OPEN priority queue
 		AstarOpen astarOpen;
-		// CLOSED set
-		AstarClosed astarClosed;
-		
-		// The maximum number of nodes generated per search. When this value is
-		// exceeded, the search must stop.
-		static constexpr int MAX_GENERATED_NODES = 5000;
+		// Node of each generated cell. The generated cells which are not in
+		// OPEN form the CLOSED set.
+		StampedArray<AstarNodeIdx> cellNodes;
+
+		// The maximum number of nodes generated per search (which may span
+		// several plannings). When this value is exceeded, the search must
+		// stop.
+		static constexpr int MAX_GENERATED_NODES = 50000;
 		// The number of nodes generated during this search
 		int generatedNodes;
 
+		// Whether there is a search to resume
+		bool isActive;
 		// Whether the search has finished
 		bool isFinished;
-		// The best input as chosen by the search
-		PlayerInputFlags bestInput;
 
 #if ASTAR_PREDATOR_VERSION == 3
 		// The node which has been nearest to the goal during this search
-		AstarNodeP nearestNode;
+		AstarNodeIdx nearestNode;
 #endif // ASTAR_PREDATOR_VERSION == 3
 #ifdef DO_LOG_ASTAR_PREDATOR
 		AutoLogger_NodesSqdist* sqdistLogger;
@@ -230,13 +129,18 @@ private:
 	// The actions are limited to cardinal only, because diagonal movement
 	// is more likely to not work correctly.
 	static constexpr AstarActions ASTAR_ACTIONS{DIR8_N, DIR8_E, DIR8_S, DIR8_W};
+	// The number of nodes generated per planning if the plan budget is not
+	// time
+	static constexpr uint64_t PLAN_WORK_LIMIT = 5000;
 
 	PlayerInputFlags m_input;
+	// The current search
+	AstarData m_search;
 
 	/**
 	 * @brief Chooses which action to take next.
 	 * 
-	 * @note Performs A* search.
+	 * @note Performs (or resumes) A* search.
 	 * 
 	 * @param victim The player to chase after.
 	 */
@@ -244,34 +148,42 @@ private:
 		const GameStateAgentProxy::PlayerState* victim);
 	
 	/**
-	 * @brief Creates an `AstarData` structure.
+	 * @brief Checks whether the search `d` may be resumed.
 	 * 
-	 * @param victim The player to chase after.
-	 * 
-	 * @note The `astarDataInit` method must be called afterwards to properly
-	 *       initialize the structure. This method only takes care of its
-	 *       successful creation.
+	 * @param d
+	 * @param sStart Current initial state.
+	 * @param sGoal Current goal state.
 	 */
-	AstarPredatorAIPlayerAgent::AstarData astarDataCreate(
-		const GameStateAgentProxy::PlayerState* victim) const;
+	bool isAstarResumable(const AstarData& d, CellIndex sStart,
+		CellIndex sGoal) const;
 	/**
-	 * @brief Initializes the values of `AstarData` structure.
+	 * @brief Initializes `AstarData` structure for a new search.
+	 * 
+	 * @param d
+	 * @param sStart Initial state.
+	 * @param sGoal Goal state.
 	 */
-	void astarDataInit(AstarData& d) const;
+	void astarDataInit(AstarData& d, CellIndex sStart, CellIndex sGoal) const;
 	/**
 	 * @brief Fully processes the node at the top of OPEN.
 	 * 
+	 * @param d
+	 * @param passability Passability of the grid for "my" bubble.
+	 * 
 	 * @note May modify `d.isFinished` (besides others). Once the value of this
 	 *       variable is set to `true`, the search should not continue.
 	 */
-	void astarProcessNextNode(AstarData& d) const;
+	void astarProcessNextNode(AstarData& d,
+		const StageGridModel::Passability& passability);
 	/**
 	 * @brief Performs node "expansion".
 	 * 
 	 * @param d
 	 * @param n The node to expand.
+	 * @param passability Passability of the grid for "my" bubble.
 	 */
-	void astarExpandNode(AstarData& d, const AstarNodeP& n) const;
+	void astarExpandNode(AstarData& d, AstarNodeIdx n,
+		const StageGridModel::Passability& passability);
 	/**
 	 * @brief Checks if A* should finish the execution.
 	 */
@@ -279,8 +191,12 @@ private:
 	/**
 	 * @brief After A* search chooses the input which would be best made at the
 	 *        current state.
+	 * 
+	 * @param d
+	 * @param me Player state which belongs to this agent.
 	 */
-	PlayerInputFlags astarGetBestInput(AstarData& d) const;
+	PlayerInputFlags astarGetBestInput(AstarData& d,
+		const GameStateAgentProxy::PlayerState& me) const;
 #if ASTAR_PREDATOR_VERSION == 3
 	/**
 	 * @brief Changes `d.nearestNode` for the node at the top of OPEN if it is
@@ -291,28 +207,39 @@ private:
 	void astarRefreshNearestNode(AstarData& d) const;
 #endif // ASTAR_PREDATOR_VERSION == 3
 
+	/**
+	 * @brief Returns the node of the cell at the top of OPEN.
+	 */
+	static const AstarPredatorAIPlayerAgent::AstarNode& astarGetOpenTop(
+		const AstarData& d);
+
 	/**
 	 * @brief Calculates the `h(s)` value of the state `s`.
 	 * 
+	 * @param grid
 	 * @param s 
 	 * @param sGoal Goal state.
 	 */
 	static AstarPredatorAIPlayerAgent::NodeEval getHvalue(
-		const StageGridModel::Cell& s, const StageGridModel::Cell& sGoal);
+		const StageGridModel& grid, CellIndex s, CellIndex sGoal);
 	/**
 	 * @brief Creates successor of the `n` node in the `direction` direction.
 	 * 
+	 * @param grid
 	 * @param n Node to generate successor for.
+	 * @param s State of the successor.
 	 * @param direction The direction of the successor from the `n` node.
 	 * @param sGoal Goal state.
 	 */
-	static AstarPredatorAIPlayerAgent::AstarNodeP getSucc(
-		const AstarPredatorAIPlayerAgent::AstarNodeP& n, Direction8 direction,
-		const StageGridModel::Cell& sGoal);
+	static AstarPredatorAIPlayerAgent::AstarNode getSucc(
+		const StageGridModel& grid,
+		const AstarPredatorAIPlayerAgent::AstarNode& n, CellIndex s,
+		Direction8 direction, CellIndex sGoal);
 
 protected:
 	void doPlan() override;
 	PlayerInputFlags doGetPlayerInput() override { return m_input; }
+	uint64_t getPlanWorkLimit() const override { return PLAN_WORK_LIMIT; }
 public:
 	AstarPredatorAIPlayerAgent(PlayerId playerId);
 };
@@ -34,12 +34,12 @@ PlayerInputFlags BFSPredatorAIPlayerAgent::chooseNextAction(
 
 	const auto& me = getMyState();
 	const auto& grid = gsProxy->getStageGridModel();
-	auto mySqsize = sqr(me.size);
+	auto passability = grid.getPassability(sqr(me.size));
 
 	// Initial state
-	auto sStart = grid.getCellAt(me.pos);
+	auto sStart = grid.getCellIndexAt(me.pos);
 	// Goal state
-	auto sGoal = grid.getCellAt(victim->pos);
+	auto sGoal = grid.getCellIndexAt(victim->pos);
 
 	// Already in goal?
 	if (sStart == sGoal) return PlayerInputFlags();
@@ -49,63 +49,73 @@ PlayerInputFlags BFSPredatorAIPlayerAgent::chooseNextAction(
 	// work correctly.
 	std::array<Direction8, 4> bfsActions{DIR8_N, DIR8_E, DIR8_S, DIR8_W};
 
-	BFSOpen bfsOpen;
-	BFSClosed bfsClosed;
+	if (m_bfsCellNodes.size() != grid.getCellCount()) {
+		m_bfsCellNodes.resize(grid.getCellCount());
+	}
+	m_bfsNodes.reset();
+	m_bfsCellNodes.clear();
 
 	// Initial node
-	auto idsStart = std::make_shared<BFSNode>(BFSNode{
+	auto bfsStart = m_bfsNodes.add(BFSNode{
 		sStart,             // cell
 		PlayerInputFlags(), // action
-		nullptr             // prev
+		BFSNodes::NO_NODE   // prev
 	});
-	bfsOpen.push(idsStart);
+	m_bfsCellNodes.set(sStart, bfsStart);
 #ifdef INCLUDE_BENCHMARK
 	sqdistLogger.incNodeCount();
 #endif // INCLUDE_BENCHMARK
 
+	// Front of the OPEN queue; the nodes before it are CLOSED
+	BFSNodeIdx bfsOpenFront = bfsStart;
+
 	// When OPEN is empty, it is unsuccessful search.
-	while (!bfsOpen.empty()) {
-		// `currNode = bfsOpen.pop()`
-		auto currNode = bfsOpen.front();
-		bfsOpen.pop();
-		// ... and add the popped node to CLOSED
-		bfsClosed.insert(currNode);
+	while (bfsOpenFront < m_bfsNodes.size()) {
+		// `currNode = bfsOpen.pop()` (and add it to CLOSED)
+		auto currNode = bfsOpenFront++;
+		auto currCell = m_bfsNodes[currNode].cell;
+		// The neighbors which exist and the ones the bubble fits into
+		auto neighbors = grid.getNeighborMask(currCell);
+		auto fitNeighbors = passability.getNeighborMask(currCell);
 
 		// Expand
 		for (auto bfsAction : bfsActions) {
-			if (currNode->cell.hasNeighbor(bfsAction)) {
+			auto actionBit = StageGridModel::getDirectionBit(bfsAction);
+			if (neighbors & actionBit) {
 				// The action is legal in this state.
 
-				auto bfsSucc = std::make_shared<BFSNode>(BFSNode{
-					currNode->cell.getNeighbor(bfsAction), // cell
-					bfsAction,                             // action
-					currNode.get()                         // prev
-				});
+				auto succCell = grid.getNeighbor(currCell, bfsAction);
 #ifdef DO_LOG_BFS
 				sqdistLogger.incNodeCount();
 #endif // DO_LOG_BFS
 
 				// The cell must be accessible by the player.
-				if (bfsSucc->cell.getNearestObstacleDistance() > mySqsize) {
-					if (bfsSucc->cell == sGoal) {
+				if (fitNeighbors & actionBit) {
+					if (succCell == sGoal) {
 						// Found path
 
-						auto goalPtr = bfsSucc.get();
+						if (currNode == bfsStart) {
+							return PlayerInputFlags(bfsAction);
+						}
 
 						// Find the node at the depth just below the root.
-						while (goalPtr->prev->cell != sStart) {
-							goalPtr = goalPtr->prev;
+						auto goalIdx = currNode;
+						while (m_bfsNodes[goalIdx].prev != bfsStart) {
+							goalIdx = m_bfsNodes[goalIdx].prev;
 						}
 
-						return goalPtr->action;
+						return m_bfsNodes[goalIdx].action;
 					}
 
-					if (!bfsOpen.contains(bfsSucc)
-						&& bfsClosed.find(bfsSucc) == bfsClosed.end())
-					{
+					if (!m_bfsCellNodes.contains(succCell)) {
 						// Brand new state
 
-						bfsOpen.push(bfsSucc);
+						auto bfsSucc = m_bfsNodes.add(BFSNode{
+							succCell,  // cell
+							bfsAction, // action
+							currNode   // prev
+						});
+						m_bfsCellNodes.set(succCell, bfsSucc);
 					}
 				}
 			}
@@ -16,6 +16,7 @@
 #include <unordered_map>
 
 #include "aiplayeragent/StageGridModel.hpp"
+#include "core/forwardmodel/ForwardModel.hpp"
 #include "core/geometry/Geometry.hpp"
 #include "core/stageobstacles/StageObstacles.hpp"
 #include "playerinput/PlayerInputFlags.hpp"
@@ -48,6 +49,14 @@ public:
 	 * @brief Returns the grid-like model of the stage.
 	 */
 	virtual const StageGridModel& getStageGridModel() const = 0;
+	/**
+	 * @brief Creates a simulation of the current game state.
+	 * 
+	 * @details Unlike `calculateNewPlayerPos()`, the model moves all the
+	 *          players at once and resolves their collisions. It can be
+	 *          copied cheaply to explore several branches of the game.
+	 */
+	virtual ForwardModel createForwardModel() const = 0;
 	/**
 	 * @brief Calculates the increment in X and Y coordinate of a player based
 	 *        on their input.
@@ -12,6 +12,7 @@
 #ifndef IAIPLAYERAGENT_HPP
 #define IAIPLAYERAGENT_HPP
 
+#include "functions.hpp"
 #include "aiplayeragent/GameStateAgentProxy.hpp"
 #include "playerinput/IPlayerInput.hpp"
 
@@ -29,14 +30,16 @@ public:
 	/**
 	 * @brief Returns the desired agent actions.
 	 * 
-	 * @details If the planning is not finished, waits until it is.
+	 * @details Called only after the planning has finished.
 	 */
 	virtual PlayerInputFlags getPlayerInput() = 0;
 	/**
 	 * @brief Tells the agent it may start planning.
 	 * 
-	 * @details The planning will be run in a separate thread. If the planning
-	 *          is already running, waits until it's finished.
+	 * @details The agents may plan in parallel (on the worker threads of the
+	 *          core), so the planning must not modify anything shared with the
+	 *          other agents. The game state does not change until the planning
+	 *          is finished.
 	 * 
 	 *          The game state proxy must have been assigned using the 
 	 *          `assignProxy()` method before calling this method.
@@ -55,6 +58,25 @@ public:
 	 *          agents as a constructor parameter).
 	 */
 	virtual void assignProxy(GameStateAgentProxyP value) = 0;
+	/**
+	 * @brief Seeds the random number engine of the agent.
+	 * 
+	 * @details Called by `Core` before the game starts, so the decisions of
+	 *          the agent are reproducible for the same match seed.
+	 */
+	virtual void seedRNG(RNGSeedType seed) = 0;
+	/**
+	 * @brief Sets the time budget of a single planning.
+	 * 
+	 * @details The agents which search suspend the search once the budget is
+	 *          exhausted and resume it in the next planning (if the search is
+	 *          still relevant).
+	 * 
+	 * @param ms Time budget in milliseconds. If zero, the agents do a fixed
+	 *           amount of work per planning instead, so their decisions are
+	 *           reproducible.
+	 */
+	virtual void setPlanBudget(double ms) = 0;
 	/**
 	 * @brief Kill the agent.
 	 * 
@@ -37,11 +37,12 @@ PlayerInputFlags IDSPredatorAIPlayerAgent::chooseNextAction(
 
 	const auto& me = getMyState();
 	const auto& grid = gsProxy->getStageGridModel();
+	auto passability = grid.getPassability(sqr(me.size));
 
 	// Initial state
-	auto sStart = grid.getCellAt(me.pos);
+	auto sStart = grid.getCellIndexAt(me.pos);
 	// Goal state
-	auto sGoal = grid.getCellAt(victim->pos);
+	auto sGoal = grid.getCellIndexAt(victim->pos);
 
 	// Already in goal?
 	if (sStart == sGoal) return PlayerInputFlags();
@@ -51,17 +52,17 @@ PlayerInputFlags IDSPredatorAIPlayerAgent::chooseNextAction(
 	// work correctly.
 	std::array<Direction8, 4> idsActions{DIR8_N, DIR8_E, DIR8_S, DIR8_W};
 
-	IDSOpen idsOpen;
-#ifdef USE_CLOSED_LIST
-	IDSClosed idsClosed;
-#endif // USE_CLOSED_LIST
+	if (m_idsOpenCells.size() != grid.getCellCount()) {
+		m_idsOpenCells.resize(grid.getCellCount());
+		m_idsClosed.resize(grid.getCellCount());
+	}
 
 	// Initial node
-	auto idsStart = std::make_shared<IDSNode>(IDSNode{
+	IDSNode idsStart{
 		sStart,             // cell
 		0,                  // depth
 		0,                  // actionIdx
-	});
+	};
 	// Do not add the start node to the OPEN yet!
 #ifdef DO_LOG_IDS
 	sqdistLogger.incNodeCount(); // Is not added, but is generated
@@ -71,54 +72,58 @@ PlayerInputFlags IDSPredatorAIPlayerAgent::chooseNextAction(
 	// Once the max depth has not been reached the search stops (unsuccessful).
 	for (int maxDepth = 1; reachedMaxDepth; ++maxDepth) {
 		reachedMaxDepth = false;
-		idsStart->actionIdx = 0;
-		idsOpen.push(idsStart);
+		m_idsOpen.reset();
+		m_idsOpenCells.clear();
+		m_idsOpenCells.set(idsStart.cell, m_idsOpen.add(idsStart));
 #ifdef USE_CLOSED_LIST
-		idsClosed.clear();
+		m_idsClosed.clear();
 #endif // USE_CLOSED_LIST
 
-		while (!idsOpen.empty()) {
-			auto currNode = idsOpen.top();
+		while (!m_idsOpen.empty()) {
+			auto& currNode = m_idsOpen.back();
 
-			if (currNode->actionIdx == idsActions.size()) {
+			if (currNode.actionIdx == idsActions.size()) {
 				// All actions have been tried
 #ifdef USE_CLOSED_LIST
-				idsClosed.insert(idsOpen.top());
+				m_idsClosed.set(currNode.cell, currNode.depth);
 #endif // USE_CLOSED_LIST
-				idsOpen.pop();
+				m_idsOpenCells.erase(currNode.cell);
+				m_idsOpen.pop();
 			} else {
-				auto action = idsActions[currNode->actionIdx];
-				++currNode->actionIdx;
+				auto action = idsActions[currNode.actionIdx];
+				++currNode.actionIdx;
 
-				if (currNode->cell.hasNeighbor(action)) {
+				auto actionBit = StageGridModel::getDirectionBit(action);
+				if (grid.getNeighborMask(currNode.cell) & actionBit) {
 					// Action can be applied.
 
-					auto idsSucc = std::make_shared<IDSNode>(IDSNode{
-						currNode->cell.getNeighbor(action), // cell
-						currNode->depth + 1,                // depth
-						0,                                  // actionIdx
-					});
+					auto succCell = grid.getNeighbor(currNode.cell, action);
+					IDSNode idsSucc{
+						succCell,           // cell
+						currNode.depth + 1, // depth
+						0,                  // actionIdx
+					};
 #ifdef DO_LOG_IDS
 					sqdistLogger.incNodeCount();
 #endif // DO_LOG_IDS
 
-					if (idsSucc->cell.getNearestObstacleDistance() > sqr(me.size))
-					if (!idsOpen.contains(idsSucc)
+					if (passability.getNeighborMask(currNode.cell) & actionBit)
+					if (!m_idsOpenCells.contains(idsSucc.cell)
 #ifdef USE_CLOSED_LIST
-						&& !(idsClosed.find(idsSucc) != idsClosed.end())
+						&& !m_idsClosed.contains(idsSucc.cell)
 #endif // USE_CLOSED_LIST
 					) {
 						// The node is not a duplicate of another one.
 
-						if (idsSucc->cell == sGoal) {
+						if (succCell == sGoal) {
 							// Found the path
 
 							// The optimal action is the last action which has
 							// been taken in the root.
 							auto optimalAction =
-								idsActions[idsStart->actionIdx - 1];
+								idsActions[m_idsOpen[0].actionIdx - 1];
 							return PlayerInputFlags(optimalAction);
-						} else if (idsSucc->depth == maxDepth) {
+						} else if (idsSucc.depth == maxDepth) {
 							// The node lies in the maximum depth
 
 							reachedMaxDepth = true;
@@ -128,7 +133,9 @@ PlayerInputFlags IDSPredatorAIPlayerAgent::chooseNextAction(
 						} else {
 							// Not a goal, not in the max depth
 
-							idsOpen.push(idsSucc);
+							// Invalidates `currNode`
+							m_idsOpenCells.set(idsSucc.cell,
+								m_idsOpen.add(idsSucc));
 						}
 					}
 				}
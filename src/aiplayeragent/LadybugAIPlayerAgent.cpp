@@ -11,11 +11,9 @@
 
 #include "aiplayeragent/LadybugAIPlayerAgent.hpp"
 
-#include <cstdlib>
-
 void LadybugAIPlayerAgent::doPlan()
 {
-	auto randVal = rand();
+	auto randVal = rng();
 	if ((randVal % 256) < (1 << 4)) {
 		// Try new input
 
@@ -11,6 +11,8 @@
 
 #include "aiplayeragent/MinimaxPreyAIPlayerAgent.hpp"
 
+#include <cmath>
+
 #ifdef INCLUDE_BENCHMARK
 #define DO_LOG_MINIMAX_PREY
 #endif // INCLUDE_BENCHMARK
@@ -36,16 +38,50 @@ PlayerInputFlags MinimaxPreyAIPlayerAgent::chooseNextAction(
 	auto attSqsize = sqr(attacker->size);
 
 	// Cell which belongs to this agent
-	auto myCell = grid.getCellAt(me.pos);
+	auto myCell = grid.getCellIndexAt(me.pos);
 	// Cell which belongs to the attacker
-	auto attCell = grid.getCellAt(attacker->pos);
+	auto attCell = grid.getCellIndexAt(attacker->pos);
+
+	auto& d = m_search;
+	if (!isMinimaxResumable(d, myCell, attCell, mySqsize, attSqsize)) {
+		d.maxSqsize = mySqsize;
+		d.minSqsize = attSqsize;
+		d.maxCell = myCell;
+		d.minCell = attCell;
+		d.depthLimit = 2;
+		d.bestActionIdx = 0;
+		d.isActive = true;
+		d.isFinished = false;
+		d.nodeStack.reset();
+		d.nodeStack.reserve(static_cast<size_t>(MAX_DEPTH));
+		minimaxStartIteration(d);
+	}
+
+	// A bubble fits into a cell if the distance is *at least* its size, i.e.,
+	// greater than the next smaller number
+	auto maxPassability = grid.getPassability(std::nextafter(d.maxSqsize, 0.0));
+	auto minPassability = grid.getPassability(std::nextafter(d.minSqsize, 0.0));
+
+	while (!d.isFinished && !planBudget.isExhausted()) {
+		minimaxStep(d, maxPassability, minPassability);
+	}
+
+	return minimaxGetBestInput(d, me);
+}
 
-	MinimaxStack nodeStack;
-	nodeStack.reserve(static_cast<size_t>(MAX_DEPTH));
+bool MinimaxPreyAIPlayerAgent::isMinimaxResumable(const MinimaxData& d,
+	CellIndex maxCell, CellIndex minCell, double maxSqsize, double minSqsize)
+{
+	// The cells the bubbles do not fit into depend on their sizes
+	return d.isActive && (d.maxCell == maxCell) && (d.minCell == minCell)
+		&& (d.maxSqsize == maxSqsize) && (d.minSqsize == minSqsize);
+}
 
-	MinimaxNodeP initialNode = std::make_shared<MinimaxNode>(MinimaxNode{
-		myCell,    // maxCell
-		attCell,   // minCell
+void MinimaxPreyAIPlayerAgent::minimaxStartIteration(MinimaxData& d)
+{
+	d.nodeStack.add(MinimaxNode{
+		d.maxCell, // maxCell
+		d.minCell, // minCell
 		0,         // bestActionIdx
 		0,         // nextActionIdx
 		1,         // depth
@@ -56,156 +92,166 @@ PlayerInputFlags MinimaxPreyAIPlayerAgent::chooseNextAction(
 		EVAL_HI,   // beta
 #endif // MINIMAX_PREY_VERSION != 1
 	});
-	nodeStack.push(initialNode);
-
-	// While there are any unexplored nodes within the tree
-	while (!nodeStack.empty()) {
-		auto& top = nodeStack.top();
-		// Reached max depth, or tried all actions, or (MINIMAX_PREY_VERSION
-		// > 1) alpha >= beta
-		if ((top->depth == MAX_DEPTH)
-			|| (top->nextActionIdx == static_cast<int>(MINIMAX_ACTIONS.size()))
+}
+
+void MinimaxPreyAIPlayerAgent::minimaxStep(MinimaxData& d,
+	const StageGridModel::Passability& maxPassability,
+	const StageGridModel::Passability& minPassability)
+{
+	const auto& grid = gsProxy->getStageGridModel();
+
+	auto& top = d.nodeStack.back();
+	// Reached max depth, or tried all actions, or (MINIMAX_PREY_VERSION
+	// > 1) alpha >= beta
+	if ((top.depth == d.depthLimit)
+		|| (top.nextActionIdx == static_cast<int>(MINIMAX_ACTIONS.size()))
 #if MINIMAX_PREY_VERSION > 1
-			|| (top->alpha >= top->beta)
+		|| (top.alpha >= top.beta)
 #endif // MINIMAX_PREY_VERSION > 1
-		) {
-			auto pop = top;
-			nodeStack.pop();
-			if (!nodeStack.empty()) {
-				auto& newTop = nodeStack.top();
-				if (isMaxTurn(newTop)) {
-					// Max's turn in `newTop`, Min's turn in `pop`
+	) {
+		auto pop = top;
+		d.nodeStack.pop();
+		if (!d.nodeStack.empty()) {
+			auto& newTop = d.nodeStack.back();
+			if (isMaxTurn(newTop)) {
+				// Max's turn in `newTop`, Min's turn in `pop`
 #if MINIMAX_PREY_VERSION == 1
-					if (newTop->eval < pop->eval) {
-						// Found better node evaluation
+				if (newTop.eval < pop.eval) {
+					// Found better node evaluation
 
-						newTop->eval = pop->eval;
-						newTop->bestActionIdx = newTop->nextActionIdx - 1;
-					}
+					newTop.eval = pop.eval;
+					newTop.bestActionIdx = newTop.nextActionIdx - 1;
+				}
 #else // MINIMAX_PREY_VERSION != 1
-					// `beta` is the node evaluation of `pop` (Min) and `alpha`
-					// is the node evaluation of `newTop` (Max)
-					if (pop->beta > newTop->alpha) {
-						// Found better node evaluation
-
-						newTop->alpha = pop->beta;
-						newTop->bestActionIdx = newTop->nextActionIdx - 1;
-					}
+				// `beta` is the node evaluation of `pop` (Min) and `alpha`
+				// is the node evaluation of `newTop` (Max)
+				if (pop.beta > newTop.alpha) {
+					// Found better node evaluation
+
+					newTop.alpha = pop.beta;
+					newTop.bestActionIdx = newTop.nextActionIdx - 1;
+				}
 #endif // MINIMAX_PREY_VERSION != 1
-				} else {
-					// Min's turn in `newPop`, Max's turn in `pop`
+			} else {
+				// Min's turn in `newPop`, Max's turn in `pop`
 #if MINIMAX_PREY_VERSION == 1
-					if (newTop->eval > pop->eval) {
-						// Found worse node evaluation
+				if (newTop.eval > pop.eval) {
+					// Found worse node evaluation
 
-						newTop->eval = pop->eval;
-						newTop->bestActionIdx = newTop->nextActionIdx - 1;
-					}
+					newTop.eval = pop.eval;
+					newTop.bestActionIdx = newTop.nextActionIdx - 1;
+				}
 #else // MINIMAX_PREY_VERSION != 1
-					// `alpha` is the node evaluation of `pop` (Max) and `beta`
-					// is the node evaluation of `newTop` (Min)
-					if (pop->alpha < newTop->beta) {
-						// Found worse node evaluation
-
-						newTop->beta = pop->alpha;
-						newTop->bestActionIdx = newTop->nextActionIdx - 1;
-					}
+				// `alpha` is the node evaluation of `pop` (Max) and `beta`
+				// is the node evaluation of `newTop` (Min)
+				if (pop.alpha < newTop.beta) {
+					// Found worse node evaluation
+
+					newTop.beta = pop.alpha;
+					newTop.bestActionIdx = newTop.nextActionIdx - 1;
+				}
 #endif // MINIMAX_PREY_VERSION != 1
-				}	
-			}
+			}	
 		} else {
-			auto actn = MINIMAX_ACTIONS[top->nextActionIdx];
-			top->nextActionIdx++;
-			if (hasSucc(top, actn, mySqsize, attSqsize)) {
-				// The cell does have a neighbor in the `actn` direction
-
-				auto succ = getSucc(top, actn);
-				nodeStack.push(succ);
+			// Popped the root -- the iteration has finished
+
+			d.bestActionIdx = pop.bestActionIdx;
+			if (d.depthLimit >= MAX_DEPTH) {
+				d.isFinished = true;
+			} else {
+				d.depthLimit += 2;
+				minimaxStartIteration(d);
 			}
 		}
+	} else {
+		auto actn = MINIMAX_ACTIONS[top.nextActionIdx];
+		top.nextActionIdx++;
+		if (hasSucc(top, actn, maxPassability, minPassability)) {
+			// The cell does have a neighbor in the `actn` direction
+
+			// NOT a reference; adding to the stack invalidates `top`
+			auto succ = getSucc(grid, top, actn, d.depthLimit);
+			d.nodeStack.add(succ);
+			planBudget.spend();
+		}
 	}
-
-	return minimaxGetBestInput(initialNode, me);
 }
 
-MinimaxPreyAIPlayerAgent::MinimaxNodeP MinimaxPreyAIPlayerAgent::getSucc(
-	const MinimaxPreyAIPlayerAgent::MinimaxNodeP& n, Direction8 direction)
+MinimaxPreyAIPlayerAgent::MinimaxNode MinimaxPreyAIPlayerAgent::getSucc(
+	const StageGridModel& grid, const MinimaxPreyAIPlayerAgent::MinimaxNode& n,
+	Direction8 direction, int depthLimit)
 {
 	auto maxCell = (isMaxTurn(n)
-		? n->maxCell.getNeighbor(direction) // Max will move
-		: n->maxCell);                      // Max won't move
+		? grid.getNeighbor(n.maxCell, direction) // Max will move
+		: n.maxCell);                            // Max won't move
 	auto minCell = (isMaxTurn(n)
-		? n->minCell                          // Min won't move
-		: n->minCell.getNeighbor(direction)); // Min will move
-	int depth = n->depth + 1;
+		? n.minCell                               // Min won't move
+		: grid.getNeighbor(n.minCell, direction)); // Min will move
+	int depth = n.depth + 1;
 #if MINIMAX_PREY_VERSION == 1
-	NodeEval eval = (depth == MAX_DEPTH
+	NodeEval eval = (depth == depthLimit
 		// It's the leaf node -- calculate its evaluation.
-		? evalLeaf(maxCell, minCell)
+		? evalLeaf(grid, maxCell, minCell)
 		// Not the leaf node -- initialize as the worst possible evaluation for
 		// the player whose turn it is.
 		: (isMaxTurn(n) ? EVAL_HI : EVAL_LO));
 #else // MINIMAX_PREY_VERSION != 1
-	NodeEval alpha = n->alpha;
-	NodeEval beta = n->beta;
-	if (depth == MAX_DEPTH) {
-		alpha = beta = evalLeaf(maxCell, minCell);
+	NodeEval alpha = n.alpha;
+	NodeEval beta = n.beta;
+	if (depth == depthLimit) {
+		alpha = beta = evalLeaf(grid, maxCell, minCell);
 	}
 #endif // MINIMAX_PREY_VERSION != 1
 	
-	MinimaxNodeP res = std::make_shared<MinimaxNode>(MinimaxNode{
-		maxCell,   // maxCell
-		minCell,   // minCell
-		0,         // bestActionIdx
-		0,         // nextActionIdx
-		depth,     // depth
+	MinimaxNode res{
+		maxCell, // maxCell
+		minCell, // minCell
+		0,       // bestActionIdx
+		0,       // nextActionIdx
+		depth,   // depth
 #if MINIMAX_PREY_VERSION == 1
-		eval,      // eval
+		eval,    // eval
 #else // MINIMAX_PREY_VERSION != 1
-		alpha,     // alpha
-		beta,     // beta
+		alpha,   // alpha
+		beta,    // beta
 #endif // MINIMAX_PREY_VERSION != 1
-	});
+	};
 	return res;
 }
 
 bool MinimaxPreyAIPlayerAgent::hasSucc(
-	const MinimaxPreyAIPlayerAgent::MinimaxNodeP& n, Direction8 direction,
-	double maxSqsize, double minSqsize)
+	const MinimaxPreyAIPlayerAgent::MinimaxNode& n, Direction8 direction,
+	const StageGridModel::Passability& maxPassability,
+	const StageGridModel::Passability& minPassability)
 {
-	if (isMaxTurn(n)) {
-		// Is there a path?
-		if (!n->maxCell.hasNeighbor(direction)) return false;
-
-		auto neigh = n->maxCell.getNeighbor(direction);
-		// Do I fit through?
-		return (neigh.getNearestObstacleDistance() >= maxSqsize);
-	} else { // Min's turn
-		// Is there a path?
-		if (!n->minCell.hasNeighbor(direction)) return false;
-
-		auto neigh = n->minCell.getNeighbor(direction);
-		// Do I fit through?
-		return (neigh.getNearestObstacleDistance() >= minSqsize);
+	// The player whose turn it is
+	auto cell = (isMaxTurn(n) ? n.maxCell : n.minCell);
+	const auto& passability = (isMaxTurn(n) ? maxPassability : minPassability);
+
+	if (direction == DIR8_NONE) {
+		// Do I fit where I am?
+		return passability.fits(cell);
 	}
+	// Is there a path and do I fit through?
+	return (passability.getNeighborMask(cell)
+		& StageGridModel::getDirectionBit(direction));
 }
 
 bool MinimaxPreyAIPlayerAgent::isMaxTurn(
-	const MinimaxPreyAIPlayerAgent::MinimaxNodeP& n)
+	const MinimaxPreyAIPlayerAgent::MinimaxNode& n)
 {
 	// Odd turns are Max's, even turns are Min's (root is 1 -- Max).
-	return (n->depth % 2 == 1);
+	return (n.depth % 2 == 1);
 }
 
 MinimaxPreyAIPlayerAgent::NodeEval MinimaxPreyAIPlayerAgent::evalLeaf(
-	const StageGridModel::Cell& maxCell,
-	const StageGridModel::Cell& minCell)
+	const StageGridModel& grid, CellIndex maxCell, CellIndex minCell)
 {
-	return getTaxicab(maxCell, minCell);
+	return getTaxicab(grid, maxCell, minCell);
 }
 
 MinimaxPreyAIPlayerAgent::NodeEval MinimaxPreyAIPlayerAgent::getTaxicab(
-	const StageGridModel::Cell& c1,const StageGridModel::Cell& c2)
+	const StageGridModel& grid, CellIndex c1, CellIndex c2)
 {
 	// Taxicab distance:
 	//   0 1 2 3 4
@@ -214,20 +260,22 @@ MinimaxPreyAIPlayerAgent::NodeEval MinimaxPreyAIPlayerAgent::getTaxicab(
 	// 2         ()
 	// distance = 6
 
-	return abs(c1.getPosition().x() - c2.getPosition().x())
-		+  abs(c1.getPosition().y() - c2.getPosition().y());
+	const auto& c1Pos = grid.getPosition(c1);
+	const auto& c2Pos = grid.getPosition(c2);
+	return abs(c1Pos.x() - c2Pos.x())
+		+  abs(c1Pos.y() - c2Pos.y());
 }
 
 PlayerInputFlags MinimaxPreyAIPlayerAgent::minimaxGetBestInput(
-	const MinimaxPreyAIPlayerAgent::MinimaxNodeP& initialNode,
-	const GameStateAgentProxy::PlayerState& me) const
+	const MinimaxData& d, const GameStateAgentProxy::PlayerState& me) const
 {
 	// The direction taken in the root node to reach `n`
-	auto dir = MINIMAX_ACTIONS[initialNode->bestActionIdx];
+	auto dir = MINIMAX_ACTIONS[d.bestActionIdx];
 	// Neighbor of the root cell in the `dir` direction
-	auto sStartNeigh = initialNode->maxCell.getNeighbor(dir);
+	const auto& grid = gsProxy->getStageGridModel();
+	auto sStartNeigh = grid.getNeighbor(d.maxCell, dir);
 	// Position of the neighbor (i.e., the cell's center)
-	auto destPos = sStartNeigh.getPosition();
+	auto destPos = grid.getPosition(sStartNeigh);
 
 	auto bestInput = PlayerInputFlags();
 	auto bestSqdist = std::numeric_limits<double>::infinity();
@@ -261,4 +309,6 @@ void MinimaxPreyAIPlayerAgent::doPlan()
 MinimaxPreyAIPlayerAgent::MinimaxPreyAIPlayerAgent(PlayerId playerId)
 	: AIPlayerAgentBase(playerId)
 	, PreyAIPlayerAgentBase(playerId)
-{}
+{
+	m_search.isActive = false;
+}
@@ -19,15 +19,20 @@
 //    - Alpha-beta pruning
 #define MINIMAX_PREY_VERSION 2
 
+// The search is iterative deepening: the depth limit is raised by 2 (so the
+// last move is always Max's) until it reaches MAX_DEPTH. The search is
+// suspended once the plan budget is exhausted; until then the best action of
+// the deepest finished iteration is taken. The search is resumed as long as
+// the initial state does not change.
+
 #include <array>
 #include <limits>
-#include <memory>
-#include <stack>
 
 #include "types.hpp"
 #include "playerinput/PlayerInputFlags.hpp"
 #include "aiplayeragent/PreyAIPlayerAgentBase.hpp"
 #include "aiplayeragent/StageGridModel.hpp"
+#include "aiplayeragent/searchalgos/NodeArena.hpp"
 
 class MinimaxPreyAIPlayerAgent : public PreyAIPlayerAgentBase {
 private:
@@ -35,14 +40,15 @@ private:
 	typedef double NodeEval;
 	typedef Direction8 MinimaxAction;
 	typedef std::array<MinimaxAction, 5> MinimaxActions;
+	typedef StageGridModel::CellIndex CellIndex;
 	/**
 	 * @brief Node in the Minimax search tree.
 	 */
 	struct MinimaxNode {
 		// Cell corresponding to the position of the "Max" player
-		StageGridModel::Cell maxCell;
+		CellIndex maxCell;
 		// Cell corresponding to the position of the "Min" player
-		StageGridModel::Cell minCell;
+		CellIndex minCell;
 		// Index of the action leading to the best leaf node
 		int bestActionIdx;
 		// Index of the action to perform next from this node
@@ -60,17 +66,33 @@ private:
 #endif // MINIMAX_PREY_VERSION != 1
 	};
 	/**
-	 * @brief Node in the Minimax search tree.
+	 * @brief Stack for the Minimax nodes (the path from the root).
 	 */
-	typedef std::shared_ptr<MinimaxNode> MinimaxNodeP;
+	typedef NodeArena<MinimaxNode> MinimaxStack;
 	/**
-	 * @brief Stack for the Minimax nodes.
+	 * @brief State of the Minimax search (kept between the plannings).
 	 */
-	class MinimaxStack : public std::stack<MinimaxNodeP, std::vector<MinimaxNodeP>> {
-	public:
-		void reserve(size_t n) {
-			c.reserve(n);
-		}
+	struct MinimaxData {
+		// Square of the radius of Max's bubble
+		double maxSqsize;
+		// Square of the radius of Min's bubble
+		double minSqsize;
+		// Cell of Max in the root
+		CellIndex maxCell;
+		// Cell of Min in the root
+		CellIndex minCell;
+
+		MinimaxStack nodeStack;
+		// Depth limit of the current iteration
+		int depthLimit;
+
+		// Index of the best action according to the deepest finished
+		// iteration
+		int bestActionIdx;
+		// Whether there is a search to resume
+		bool isActive;
+		// Whether the iteration with the depth limit `MAX_DEPTH` has finished
+		bool isFinished;
 	};
 private:
 	// Possible actions
@@ -89,67 +111,102 @@ private:
 
 	static constexpr NodeEval EVAL_LO = std::numeric_limits<NodeEval>::min();
 	static constexpr NodeEval EVAL_HI = std::numeric_limits<NodeEval>::max();
+	// The number of nodes generated per planning if the plan budget is not
+	// time. Enough for the whole search in most states.
+	static constexpr uint64_t PLAN_WORK_LIMIT = 100000;
 
 	PlayerInputFlags m_input;
+	// The current search
+	MinimaxData m_search;
 
 	/**
 	 * @brief Chooses which action to take next.
 	 * 
-	 * @note Performs Minimax search.
+	 * @note Performs (or resumes) Minimax search.
 	 * 
 	 * @param attacker The opponent which poses the biggest threat.
 	 */
 	PlayerInputFlags chooseNextAction(
 		const GameStateAgentProxy::PlayerState* attacker);
+	/**
+	 * @brief Checks whether the search `d` may be resumed.
+	 */
+	static bool isMinimaxResumable(const MinimaxData& d, CellIndex maxCell,
+		CellIndex minCell, double maxSqsize, double minSqsize);
+	/**
+	 * @brief Starts a new iteration of the search with the depth limit
+	 *        `d.depthLimit`.
+	 */
+	static void minimaxStartIteration(MinimaxData& d);
+	/**
+	 * @brief Performs a single step of the search (processes the node at the
+	 *        top of the stack).
+	 * 
+	 * @param d
+	 * @param maxPassability Passability of the grid for Max's bubble.
+	 * @param minPassability Passability of the grid for Min's bubble.
+	 * 
+	 * @note May modify `d.isFinished` (besides others). Once the value of this
+	 *       variable is set to `true`, the search should not continue.
+	 */
+	void minimaxStep(MinimaxData& d,
+		const StageGridModel::Passability& maxPassability,
+		const StageGridModel::Passability& minPassability);
 	/**
 	 * @brief Creates successor of the `n` node in the `direction` direction.
 	 * 
+	 * @param grid
 	 * @param n Node to generate successor for.
 	 * @param direction The direction of the successor from the `n` node.
+	 * @param depthLimit Depth of the leaf nodes.
 	 */
-	static MinimaxPreyAIPlayerAgent::MinimaxNodeP getSucc(
-		const MinimaxPreyAIPlayerAgent::MinimaxNodeP& n, Direction8 direction);
+	static MinimaxPreyAIPlayerAgent::MinimaxNode getSucc(
+		const StageGridModel& grid,
+		const MinimaxPreyAIPlayerAgent::MinimaxNode& n, Direction8 direction,
+		int depthLimit);
 	/**
 	 * @brief Checks if successor can be generated.
 	 * 
 	 * @param n Node to generate successor for.
 	 * @param direction The direction of the successor from the `n` node.
-	 * @param maxSqsize Square of the radius of Max's bubble.
-	 * @param minSqsize Square of the radius of Min's bubble.
+	 * @param maxPassability Passability of the grid for Max's bubble.
+	 * @param minPassability Passability of the grid for Min's bubble.
 	 */
-	static bool hasSucc(const MinimaxPreyAIPlayerAgent::MinimaxNodeP& n,
-		Direction8 direction, double maxSqsize, double minSqsize);
+	static bool hasSucc(const MinimaxPreyAIPlayerAgent::MinimaxNode& n,
+		Direction8 direction,
+		const StageGridModel::Passability& maxPassability,
+		const StageGridModel::Passability& minPassability);
 	/**
 	 * @brief Checks whether it is Max's turn in the node `n`.
 	 */
-	static bool isMaxTurn(const MinimaxPreyAIPlayerAgent::MinimaxNodeP& n);
+	static bool isMaxTurn(const MinimaxPreyAIPlayerAgent::MinimaxNode& n);
 	/**
 	 * @brief Evaluates a leaf node.
 	 * 
+	 * @param grid
 	 * @param maxCell Max cell of the leaf node.
 	 * @param minCell Min cell of the leaf node.
 	 */
 	static MinimaxPreyAIPlayerAgent::NodeEval evalLeaf(
-		const StageGridModel::Cell& maxCell,
-		const StageGridModel::Cell& minCell);
+		const StageGridModel& grid, CellIndex maxCell, CellIndex minCell);
 	/**
 	 * @brief Calculates the taxicab distance between two nodes.
 	 */
 	static MinimaxPreyAIPlayerAgent::NodeEval getTaxicab(
-		const StageGridModel::Cell& c1, const StageGridModel::Cell& c2);
+		const StageGridModel& grid, CellIndex c1, CellIndex c2);
 	/**
 	 * @brief After Minimax search chooses the input which would be best made
 	 *        at the current state.
 	 * 
-	 * @param initialNode Current state of the game represented as MinimaxNode.
+	 * @param d
 	 * @param me Player state which belongs to this agent.
 	 */
-	PlayerInputFlags minimaxGetBestInput(
-		const MinimaxPreyAIPlayerAgent::MinimaxNodeP& initialNode,
+	PlayerInputFlags minimaxGetBestInput(const MinimaxData& d,
 		const GameStateAgentProxy::PlayerState& me) const;
 protected:
 	void doPlan() override;
 	PlayerInputFlags doGetPlayerInput() override { return m_input; }
+	uint64_t getPlanWorkLimit() const override { return PLAN_WORK_LIMIT; }
 public:
 	MinimaxPreyAIPlayerAgent(PlayerId playerId);
 };
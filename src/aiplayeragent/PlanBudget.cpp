@@ -0,0 +1,58 @@
+/**
+ * @file PlanBudget.cpp
+ * @author Tomáš Ludrovan
+ * @brief PlanBudget class
+ * @version 0.1
+ * @date 2024-05-23
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "aiplayeragent/PlanBudget.hpp"
+
+PlanBudget::PlanBudget(double timeLimit)
+	: m_timeLimit{timeLimit}
+	, m_workLimit{0}
+	, m_work{0}
+	, m_nextClockCheck{0}
+	, m_isExhausted{false}
+{}
+
+bool PlanBudget::isTimed() const
+{
+	return m_timeLimit > 0.0;
+}
+
+void PlanBudget::start(uint64_t workLimit)
+{
+	m_workLimit = workLimit;
+	m_work = 0;
+	m_nextClockCheck = CLOCK_CHECK_INTERVAL;
+	m_isExhausted = false;
+	if (isTimed()) {
+		m_deadline = Clock::now()
+			+ std::chrono::duration_cast<Clock::duration>(
+				std::chrono::duration<double, std::milli>(m_timeLimit));
+	}
+}
+
+void PlanBudget::spend(uint64_t n)
+{
+	m_work += n;
+}
+
+bool PlanBudget::isExhausted()
+{
+	if (m_isExhausted) return true;
+
+	if (isTimed()) {
+		if (m_work >= m_nextClockCheck) {
+			m_nextClockCheck = m_work + CLOCK_CHECK_INTERVAL;
+			m_isExhausted = (Clock::now() >= m_deadline);
+		}
+	} else {
+		m_isExhausted = (m_work >= m_workLimit);
+	}
+	return m_isExhausted;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file PlanBudget.hpp
+ * @author Tomáš Ludrovan
+ * @brief PlanBudget class
+ * @version 0.1
+ * @date 2024-05-23
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef PLANBUDGET_HPP
+#define PLANBUDGET_HPP
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Limits the amount of planning an agent may do in a single tick.
+ * 
+ * @details The search agents count their work in "work units" (e.g., the
+ *          generated nodes) and ask the budget whether they may continue.
+ *          Once the budget is exhausted, they suspend the search and use the
+ *          best result found so far.
+ * 
+ *          The budget is either:
+ *            - time -- the planning may take at most the given number of
+ *              milliseconds. The clock is read only once in a while, so the
+ *              limit may be exceeded by a few work units. The decisions of
+ *              the agents depend on the speed of the machine then.
+ *            - work -- the planning may do at most the given number of work
+ *              units (chosen by the agent). The decisions of the agents are
+ *              reproducible.
+ */
+class PlanBudget {
+public:
+	typedef std::chrono::steady_clock Clock;
+private:
+	// Number of work units between two readings of the clock
+	static constexpr uint64_t CLOCK_CHECK_INTERVAL = 64;
+
+	// Time limit (ms); zero if the budget is work
+	double m_timeLimit;
+	uint64_t m_workLimit;
+	uint64_t m_work;
+	// Work at which the clock is read next
+	uint64_t m_nextClockCheck;
+	Clock::time_point m_deadline;
+	bool m_isExhausted;
+public:
+	/**
+	 * @brief Constructs a new PlanBudget object.
+	 * 
+	 * @param timeLimit Time limit per planning (ms). If zero, the budget is
+	 *                  work.
+	 */
+	PlanBudget(double timeLimit = 0.0);
+
+	/**
+	 * @brief Checks whether the budget is time.
+	 */
+	bool isTimed() const;
+	/**
+	 * @brief Starts the budget of a planning.
+	 * 
+	 * @param workLimit Number of work units allowed if the budget is work.
+	 *                  Ignored if the budget is time.
+	 */
+	void start(uint64_t workLimit);
+	/**
+	 * @brief Records `n` units of work.
+	 */
+	void spend(uint64_t n = 1);
+	/**
+	 * @brief Checks whether the planning should be suspended.
+	 */
+	bool isExhausted();
+};
+
+#endif // PLANBUDGET_HPP
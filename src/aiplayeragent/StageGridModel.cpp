@@ -12,6 +12,10 @@
 #include "aiplayeragent/StageGridModel.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "core/distancefield/DistanceField.hpp"
 
 //#define LOG_CELLS
 
@@ -21,11 +25,33 @@
 #include <iostream>
 #endif // LOG_CELLS
 
-Size2d StageGridModel::GridInternal::initSize(
-	const std::vector<StageObstacle>& obstacles, const Size2d& stageSize)
+// Column and row difference between a cell and its neighbor; by the direction
+// bit indices
+static constexpr Point NEIGHBOR_DELTAS[] = {
+	Point( 0, -1), // DIR8_N
+	Point( 1, -1), // DIR8_NE
+	Point( 1,  0), // DIR8_E
+	Point( 1,  1), // DIR8_SE
+	Point( 0,  1), // DIR8_S
+	Point(-1,  1), // DIR8_SW
+	Point(-1,  0), // DIR8_W
+	Point(-1, -1), // DIR8_NW
+};
+
+StageGridModel::Passability::Passability(const StageGridModel& grid,
+	double sqsize)
+	: m_grid{&grid}
+	, m_sqsize{sqsize}
 {
-	(void)obstacles;
+	size_t bucket = getBucket(sqsize);
+	m_mayFitMasks = grid.getFitMasks(bucket);
+	m_fitMasks = (bucket < PASSABILITY_BUCKET_COUNT
+		? grid.getFitMasks(bucket + 1)
+		: nullptr);
+}
 
+Size2d StageGridModel::initSize(const Size2d& stageSize)
+{
 	// ceiling(x / CELL_SIZE)
 	Size2d res(
 		(stageSize.w - 1) / static_cast<int>(CELL_SIZE) + 1,
@@ -34,65 +60,107 @@ Size2d StageGridModel::GridInternal::initSize(
 	return res;
 }
 
-std::vector<StageGridModel::CellValue> StageGridModel::GridInternal::initCells(
-	const std::vector<StageObstacle>& obstacles, const Size2d& stageSize)
+std::array<std::ptrdiff_t, 9> StageGridModel::initNeighborOffsets(
+	const Size2d& size)
 {
-	Size2d gridSize = initSize(obstacles, stageSize);
-	std::vector<StageGridModel::CellValue> res;
-	res.reserve(gridSize.w * gridSize.h);
-
-	for (int row = 0; row < gridSize.h; ++row) {
-		for (int col = 0; col < gridSize.w; ++col) {
-			CellKey newCellKey(col, row);
-			CellValue newCellValue = {
-				newCellKey,                  // key
-				getCellPosition(newCellKey), // position
-				getCellNearestObstacleDistance(newCellKey, obstacles,
-					stageSize),              // nearestObstacleDistance
-			};
-			res.push_back(std::move(newCellValue));
-		}
-	}
-
-#ifdef LOG_CELLS
-	std::ofstream log("stage-grid-model.log");
-	for (int row = 0; row < gridSize.h; ++row) {
-		for (int col = 0; col < gridSize.w; ++col) {
-			log << std::setw(5) << std::setfill(' ') << static_cast<int>(res[row * gridSize.w + col].nearestObstacleDistance) << ' ';
-		}
-		log << '\n';
+	std::array<std::ptrdiff_t, 9> res;
+	for (size_t bit = 0; bit < 8; ++bit) {
+		res[bit] = NEIGHBOR_DELTAS[bit].y * size.w + NEIGHBOR_DELTAS[bit].x;
 	}
-#endif // LOG_CELLS
-
+	// DIR8_NONE
+	res[8] = 0;
 	return res;
 }
 
-Point_2 StageGridModel::GridInternal::getCellPosition(const CellKey& key)
+Point_2 StageGridModel::getCellPosition(int col, int row)
 {
 	Point_2 res(
 		// Top left corner  // Center
-		key.x * CELL_SIZE + (CELL_SIZE / 2),
-		key.y * CELL_SIZE + (CELL_SIZE / 2)
+		col * CELL_SIZE + (CELL_SIZE / 2),
+		row * CELL_SIZE + (CELL_SIZE / 2)
 	);
 	return res;
 }
 
-double StageGridModel::GridInternal::getCellNearestObstacleDistance(
-	const CellKey& key, const std::vector<StageObstacle>& obstacles,
-	const Size2d& stageSize)
+bool StageGridModel::getStripExtent(const StageObstacle& obstacle,
+	double ymin, double ymax, double& xmin, double& xmax)
+{
+	// The part of the triangle within the strip is a convex polygon. Its
+	// vertices are the corners within the strip and the intersections of the
+	// sides with the strip bounds.
+
+	xmin = std::numeric_limits<double>::infinity();
+	xmax = -xmin;
+	for (int i = 0; i < obstacle.CORNER_COUNT; i++) {
+		const PointF& a = obstacle.corners[i];
+		const PointF& b = obstacle.corners[(i + 1) % obstacle.CORNER_COUNT];
+
+		if (ymin <= a.y && a.y <= ymax) {
+			xmin = std::min(xmin, a.x);
+			xmax = std::max(xmax, a.x);
+		}
+		for (double y : {ymin, ymax}) {
+			if ((a.y - y) * (b.y - y) < 0.0) {
+				// The side crosses the bound
+				double x = a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+				xmin = std::min(xmin, x);
+				xmax = std::max(xmax, x);
+			}
+		}
+	}
+	return xmin <= xmax;
+}
+
+void StageGridModel::rasterizeObstacles(
+	const std::vector<StageObstacle>& obstacles,
+	std::vector<uint8_t>& occupied, int rowBegin, int rowEnd) const
 {
-	// The distance is measured as the squared distance from the cell center to
-	// the stage bounds or an obstacle. If it overlaps with an obstacle, the
-	// distance is 0. This is because of thin obstacles -- if an obstacle is
-	// thin enough, small players might think there is a path between cells
-	// separated by such obstacle.
+	const double pixelSize = CELL_SIZE / RASTER_SUBDIVISION;
+	const int rasterCols = m_size.w * RASTER_SUBDIVISION;
 
-	Point_2 pos = getCellPosition(key);
+	for (const auto& obstacle : obstacles) {
+		double ymin = obstacle.corners[0].y, ymax = ymin;
+		for (int i = 1; i < obstacle.CORNER_COUNT; i++) {
+			ymin = std::min(ymin, obstacle.corners[i].y);
+			ymax = std::max(ymax, obstacle.corners[i].y);
+		}
+
+		int obstRowBegin = std::max(static_cast<int>(
+			std::floor((ymin - RASTER_EPSILON) / pixelSize)), rowBegin);
+		int obstRowEnd = std::min(static_cast<int>(
+			std::floor((ymax + RASTER_EPSILON) / pixelSize)) + 1, rowEnd);
+
+		for (int row = obstRowBegin; row < obstRowEnd; row++) {
+			double xmin, xmax;
+			if (!getStripExtent(obstacle, row * pixelSize - RASTER_EPSILON,
+				(row + 1) * pixelSize + RASTER_EPSILON, xmin, xmax))
+			{
+				continue;
+			}
+
+			int colBegin = std::max(static_cast<int>(
+				std::floor((xmin - RASTER_EPSILON) / pixelSize)), 0);
+			int colEnd = std::min(static_cast<int>(
+				std::floor((xmax + RASTER_EPSILON) / pixelSize)) + 1,
+				rasterCols);
+			if (colBegin < colEnd) {
+				auto rowData = occupied.begin()
+					+ static_cast<size_t>(row) * rasterCols;
+				std::fill(rowData + colBegin, rowData + colEnd, 1);
+			}
+		}
+	}
+}
+
+bool StageGridModel::isCellOverlapping(int col, int row,
+	const std::vector<Triangle_2>& obstacles,
+	const std::vector<CGAL::Bbox_2>& obstacleBboxes)
+{
 	// Square PQRS is the square of the cell
-	Point_2 p(key.x * CELL_SIZE, key.y * CELL_SIZE);             // top left
-	Point_2 q((key.x + 1) * CELL_SIZE, key.y * CELL_SIZE);       // top right
-	Point_2 r((key.x + 1) * CELL_SIZE, (key.y + 1) * CELL_SIZE); // bottom right
-	Point_2 s(key.x * CELL_SIZE, (key.y + 1) * CELL_SIZE);       // bottom left
+	Point_2 p(col * CELL_SIZE, row * CELL_SIZE);             // top left
+	Point_2 q((col + 1) * CELL_SIZE, row * CELL_SIZE);       // top right
+	Point_2 r((col + 1) * CELL_SIZE, (row + 1) * CELL_SIZE); // bottom right
+	Point_2 s(col * CELL_SIZE, (row + 1) * CELL_SIZE);       // bottom left
 
 	// CGAL doesn't have a function to calculate the distance between a square
 	// and a triangle, so we have to split the square to two triangles.
@@ -101,77 +169,284 @@ double StageGridModel::GridInternal::getCellNearestObstacleDistance(
 	Triangle_2 trg1(p, q, r);
 	// Bottom left triangle
 	Triangle_2 trg2(r, s, p);
-	
-	double lSqdist = sqr(pos.x());
-	double tSqdist = sqr(pos.y());
-	double rSqdist = sqr(stageSize.w - pos.x());
-	double bSqdist = sqr(stageSize.h - pos.y());
+	CGAL::Bbox_2 cellBbox(p.x(), p.y(), r.x(), r.y());
 
-	// Result is first initialized as the minimum distance from the stage bounds
-	double res = std::min({lSqdist, tSqdist, rSqdist, bSqdist});
+	for (size_t i = 0; i < obstacles.size(); i++) {
+		if (!CGAL::do_overlap(cellBbox, obstacleBboxes[i])) continue;
 
-	for (const auto& obstacle : obstacles) {
-		auto obstTrg = toCgalTriangle(obstacle);
-		if ((CGAL::squared_distance(trg1, obstTrg) == 0.0)
-			|| (CGAL::squared_distance(trg2, obstTrg) == 0.0))
+		if ((CGAL::squared_distance(trg1, obstacles[i]) == 0.0)
+			|| (CGAL::squared_distance(trg2, obstacles[i]) == 0.0))
 		{
-			// Cell overlaps with the obstacle
-			return 0.0;
+			return true;
 		}
-		// Otherwise, the distance is measured from the cell center.
-		double sqdist = CGAL::squared_distance(pos, toCgalTriangle(obstacle));
+	}
+	return false;
+}
+
+double StageGridModel::measureNearestObstacleDistance(const Point_2& pos,
+	const std::vector<Triangle_2>& obstacles,
+	const std::vector<CGAL::Bbox_2>& obstacleBboxes, double maxSqdist)
+{
+	double res = maxSqdist;
+	for (size_t i = 0; i < obstacles.size(); i++) {
+		// The bounding box is never farther than the obstacle
+		const auto& bbox = obstacleBboxes[i];
+		double dx = std::max({bbox.xmin() - pos.x(), pos.x() - bbox.xmax(),
+			0.0});
+		double dy = std::max({bbox.ymin() - pos.y(), pos.y() - bbox.ymax(),
+			0.0});
+		if (sqr(dx) + sqr(dy) > res) continue;
+
+		double sqdist = CGAL::squared_distance(pos, obstacles[i]);
 		// res = min(res, sqdist)
 		if (res > sqdist) res = sqdist;
 	}
+	return res;
+}
 
+double StageGridModel::getBucketBoundSqsize(size_t bound)
+{
+	return sqr(bound * PASSABILITY_BUCKET_SIZE);
+}
+
+size_t StageGridModel::getBucket(double sqsize)
+{
+	// Guess from the size, then fix the rounding errors of the square root
+	size_t res = std::min(
+		static_cast<size_t>(std::sqrt(std::max(sqsize, 0.0))
+			/ PASSABILITY_BUCKET_SIZE),
+		PASSABILITY_BUCKET_COUNT);
+	while (res > 0 && getBucketBoundSqsize(res) > sqsize) {
+		res--;
+	}
+	while (res < PASSABILITY_BUCKET_COUNT
+		&& getBucketBoundSqsize(res + 1) <= sqsize)
+	{
+		res++;
+	}
 	return res;
 }
 
-size_t StageGridModel::GridInternal::keyToIdx(const CellKey& key) const
+size_t StageGridModel::getFitBoundCount(double nearestObstacleDistance)
 {
-	       // skip rows       // skip columns
-	return key.y * m_size.w + key.x;
+	// The bound 0 (i.e., not overlapping with an obstacle) first; the cells
+	// which fit a larger bound fit the smaller ones too
+	size_t res = 0;
+	while (res <= PASSABILITY_BUCKET_COUNT
+		&& nearestObstacleDistance > getBucketBoundSqsize(res))
+	{
+		res++;
+	}
+	return res;
 }
 
-StageGridModel::GridInternal::GridInternal(
-	const std::vector<StageObstacle>& obstacles, const Size2d& stageSize)
-	: m_size{initSize(obstacles, stageSize)}
-	, m_cells{initCells(obstacles, stageSize)}
-{}
+void StageGridModel::initNearestObstacleDistances(
+	const std::vector<StageObstacle>& obstacles, const Size2d& stageSize,
+	WorkerPool* workerPool)
+{
+	static constexpr double INF = std::numeric_limits<double>::infinity();
+	const double pixelSize = CELL_SIZE / RASTER_SUBDIVISION;
+	const int rasterCols = m_size.w * RASTER_SUBDIVISION;
+	const int rasterRows = m_size.h * RASTER_SUBDIVISION;
+
+	// Rasterize
+	std::vector<uint8_t> occupied(
+		static_cast<size_t>(rasterCols) * rasterRows, 0);
+	WorkerPool::runOptional(workerPool, rasterRows, [this, &obstacles,
+		&occupied](size_t chunk, size_t begin, size_t end)
+	{
+		(void)chunk;
+		rasterizeObstacles(obstacles, occupied, static_cast<int>(begin),
+			static_cast<int>(end));
+	});
+
+	// Transform
+	std::vector<double> raster(occupied.size());
+	for (size_t i = 0; i < raster.size(); i++) {
+		raster[i] = occupied[i] ? 0.0 : INF;
+	}
+	DistanceField::squaredDistanceTransform(raster, rasterCols, rasterRows,
+		workerPool);
+
+	// Any point of the occupied pixel is at most half of the diagonal away
+	// from the pixel center
+	const double halfPixelDiagonal = std::sqrt(2.0) * pixelSize / 2.0
+		+ 2.0 * RASTER_EPSILON;
+
+	std::vector<Triangle_2> obstacleShapes;
+	std::vector<CGAL::Bbox_2> obstacleBboxes;
+	obstacleShapes.reserve(obstacles.size());
+	obstacleBboxes.reserve(obstacles.size());
+	for (const auto& obstacle : obstacles) {
+		obstacleShapes.push_back(toCgalTriangle(obstacle));
+		obstacleBboxes.push_back(obstacleShapes.back().bbox());
+	}
+
+	m_nearestObstacleDistances.resize(m_positions.size());
+	WorkerPool::runOptional(workerPool, m_size.h, [&](size_t chunk,
+		size_t begin, size_t end)
+	{
+		(void)chunk;
+
+		for (int row = static_cast<int>(begin); row < static_cast<int>(end);
+			++row)
+		{
+			for (int col = 0; col < m_size.w; ++col) {
+				CellIndex idx = row * m_size.w + col;
+				// The top left pixel of the cell
+				size_t pixelIdx =
+					static_cast<size_t>(row * RASTER_SUBDIVISION) * rasterCols
+					+ col * RASTER_SUBDIVISION;
+
+				// If the cell overlaps with an obstacle, the distance is 0.
+				// This is because of thin obstacles -- if an obstacle is thin
+				// enough, small players might think there is a path between
+				// cells separated by such obstacle.
+				bool mayOverlap = false;
+				bool isOverlapping = false;
+				for (int i = 0; i < RASTER_SUBDIVISION; i++) {
+					for (int j = 0; j < RASTER_SUBDIVISION; j++) {
+						if (occupied[pixelIdx
+							+ static_cast<size_t>(i) * rasterCols + j] == 0)
+						{
+							continue;
+						}
+						mayOverlap = true;
+						// The inner pixels lie within the cell even when
+						// inflated
+						isOverlapping = isOverlapping || ((i > 0)
+							&& (i < RASTER_SUBDIVISION - 1) && (j > 0)
+							&& (j < RASTER_SUBDIVISION - 1));
+					}
+				}
+				if (mayOverlap && !isOverlapping) {
+					isOverlapping = isCellOverlapping(col, row, obstacleShapes,
+						obstacleBboxes);
+				}
+				if (isOverlapping) {
+					m_nearestObstacleDistances[idx] = 0.0;
+					continue;
+				}
+
+				// Otherwise, the distance is measured from the cell center
+				// (which is the center of the middle pixel)
+				const Point_2& pos = m_positions[idx];
+				size_t centerIdx = pixelIdx
+					+ static_cast<size_t>(RASTER_SUBDIVISION / 2) * rasterCols
+					+ RASTER_SUBDIVISION / 2;
+
+				double lSqdist = sqr(pos.x());
+				double tSqdist = sqr(pos.y());
+				double rSqdist = sqr(stageSize.w - pos.x());
+				double bSqdist = sqr(stageSize.h - pos.y());
+				// The obstacle overlapping with the nearest occupied pixel
+				double oSqdist = sqr(std::sqrt(raster[centerIdx]) * pixelSize
+					+ halfPixelDiagonal);
+
+				m_nearestObstacleDistances[idx] =
+					measureNearestObstacleDistance(pos, obstacleShapes,
+						obstacleBboxes, std::min({lSqdist, tSqdist, rSqdist,
+							bSqdist, oSqdist}));
+			}
+		}
+	});
+}
+
+void StageGridModel::initFitMasks()
+{
+	const size_t cellCount = getCellCount();
+	// The number of the bounds each cell fits. There is a border of cells
+	// which do not exist, so the edge cells need no special care.
+	const int paddedCols = m_size.w + 2;
+	std::vector<uint8_t> fitBoundCounts(
+		static_cast<size_t>(paddedCols) * (m_size.h + 2), 0);
+	for (int row = 0; row < m_size.h; ++row) {
+		for (int col = 0; col < m_size.w; ++col) {
+			fitBoundCounts[(row + 1) * paddedCols + (col + 1)] =
+				static_cast<uint8_t>(getFitBoundCount(
+					m_nearestObstacleDistances[row * m_size.w + col]));
+		}
+	}
+
+	m_fitMasks.assign((PASSABILITY_BUCKET_COUNT + 1) * cellCount, 0);
+	for (int row = 0; row < m_size.h; ++row) {
+		for (int col = 0; col < m_size.w; ++col) {
+			CellIndex idx = row * m_size.w + col;
+
+			// The neighbors which fit exactly the given number of bounds
+			std::array<NeighborMask, PASSABILITY_BUCKET_COUNT + 2> lastFits{};
+			for (size_t bit = 0; bit < 8; ++bit) {
+				auto neighCount = fitBoundCounts[
+					(row + 1 + NEIGHBOR_DELTAS[bit].y) * paddedCols
+					+ (col + 1 + NEIGHBOR_DELTAS[bit].x)];
+				lastFits[neighCount] |= static_cast<NeighborMask>(1u << bit);
+			}
+
+			// The neighbors which fit the bound; the larger bounds are
+			// subsets of the smaller ones
+			auto mask = static_cast<NeighborMask>(~lastFits[0]);
+			for (size_t bound = 0;
+				mask != 0 && bound <= PASSABILITY_BUCKET_COUNT; ++bound)
+			{
+				m_fitMasks[bound * cellCount + idx] = mask;
+				mask &= static_cast<NeighborMask>(~lastFits[bound + 1]);
+			}
+		}
+	}
+}
 
-bool StageGridModel::GridInternal::isCellAt(
-	const StageGridModel::CellKey& key) const
+const StageGridModel::NeighborMask* StageGridModel::getFitMasks(
+	size_t bound) const
 {
-	return (0 <= key.x && key.x < m_size.w) // Within vertical bounds
-		&& (0 <= key.y && key.y < m_size.h) // Within horizontal bounds
-		&& (at(key).nearestObstacleDistance != 0.0); // Not overlapping with
-		                                             // and obstacle
+	return m_fitMasks.data() + bound * getCellCount();
 }
 
-const StageGridModel::CellValue& StageGridModel::GridInternal::at(
-	const StageGridModel::CellKey& key) const
+StageGridModel::StageGridModel(const std::vector<StageObstacle>& obstacles,
+	const Size2d& stageSize, WorkerPool* workerPool)
+	: m_size{initSize(stageSize)}
+	, m_neighborOffsets{initNeighborOffsets(m_size)}
 {
-	return m_cells.at(keyToIdx(key));
+	m_positions.reserve(m_size.w * m_size.h);
+	for (int row = 0; row < m_size.h; ++row) {
+		for (int col = 0; col < m_size.w; ++col) {
+			m_positions.push_back(getCellPosition(col, row));
+		}
+	}
+
+	initNearestObstacleDistances(obstacles, stageSize, workerPool);
+	initFitMasks();
+
+#ifdef LOG_CELLS
+	std::ofstream log("stage-grid-model.log");
+	for (int row = 0; row < m_size.h; ++row) {
+		for (int col = 0; col < m_size.w; ++col) {
+			log << std::setw(5) << std::setfill(' ') << static_cast<int>(m_nearestObstacleDistances[row * m_size.w + col]) << ' ';
+		}
+		log << '\n';
+	}
+#endif // LOG_CELLS
 }
 
-StageGridModel::CellKey StageGridModel::GridInternal::getCellAtPos(
+StageGridModel::CellIndex StageGridModel::getCellIndexAt(
 	const Point_2& p) const
 {
 	// floor(xy / CELL_SIZE)
-	CellKey res(
-		static_cast<int>(p.x() / CELL_SIZE),
-		static_cast<int>(p.y() / CELL_SIZE)
-	);
-	return res;
+	int col = static_cast<int>(p.x() / CELL_SIZE);
+	int row = static_cast<int>(p.y() / CELL_SIZE);
+	col = std::clamp(col, 0, m_size.w - 1);
+	row = std::clamp(row, 0, m_size.h - 1);
+	       // skip rows       // skip columns
+	return row * m_size.w + col;
 }
 
-StageGridModel::StageGridModel(const std::vector<StageObstacle>& obstacles,
-	const Size2d& stageSize)
-	: m_gridInternal(obstacles, stageSize)
-{}
+size_t StageGridModel::getCellCount() const
+{
+	return m_nearestObstacleDistances.size();
+}
 
-StageGridModel::Cell StageGridModel::getCellAt(const Point_2& p) const
+StageGridModel::Passability StageGridModel::getPassability(
+	double sqsize) const
 {
-	Cell res(m_gridInternal, m_gridInternal.getCellAtPos(p));
+	Passability res(*this, sqsize);
 	return res;
 }
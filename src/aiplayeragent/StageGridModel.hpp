@@ -12,184 +12,298 @@
 #ifndef STAGEGRIDMODEL_HPP
 #define STAGEGRIDMODEL_HPP
 
-#include <cassert>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "types.hpp"
 #include "core/Common.hpp"
 #include "core/geometry/Geometry.hpp"
+#include "core/workerpool/WorkerPool.hpp"
 
 /**
  * @brief Grid-like model of the stage.
+ * 
+ * @details The cells are indexed by rows. Their properties are stored in
+ *          separate arrays (structure of arrays), so the searches touch only
+ *          the data they need.
+ * 
+ *          The neighbors of a cell are described by an 8-bit mask (one bit per
+ *          direction, see `getDirectionBit()`). Besides the mask of existing
+ *          neighbors, the model precomputes the masks of the neighbors a
+ *          bubble fits into for a set of bubble size buckets. See
+ *          `Passability`.
  */
 class StageGridModel {
-private:
-	typedef Point CellKey;
-	struct CellValue {
-		CellKey key;
-		Point_2 position;
-		double nearestObstacleDistance;
-	};
-
-	class GridInternal {
-	private:
-		// Cell width/height
-		// It would make sense to keep this value equal to the maximum distance
-		// a player may move by during a single turn. Given the implementation
-		// in the Core it is MAX_SPEED * TICK_INTERVAL (1.0 * 17). Ideally, this
-		// constant should be derived from that instead of having a fixed value,
-		// but at this point I don't even care...
-		static constexpr double CELL_SIZE = 17.0;
-
-		const Size2d m_size;
-		// Stored by rows
-		std::vector<CellValue> m_cells;
-
-		/**
-		 * @brief Creates initial value for the `m_size` variable.
-		 */
-		static Size2d initSize(const std::vector<StageObstacle>& obstacles,
-			const Size2d& stageSize);
-		/**
-		 * @brief Creates initial value for the `m_cells` variable.
-		 */
-		static std::vector<StageGridModel::CellValue> initCells(
-			const std::vector<StageObstacle>& obstacles,
-			const Size2d& stageSize);
-		/**
-		 * @brief Calcualtes the position of a cell with the given `key`.
-		 */
-		static Point_2 getCellPosition(const CellKey& key);
-		/**
-		 * @brief Calcualtes the square of the shortest distance between an
-		 *        obstacle and a cell with the given `key`.
-		 */
-		static double getCellNearestObstacleDistance(const CellKey& key,
-			const std::vector<StageObstacle>& obstacles,
-			const Size2d& stageSize);
-		/**
-		 * @brief Returns the index of a cell within the `m_cells` variable.
-		 */
-		size_t keyToIdx(const CellKey& key) const;
-	public:
-		GridInternal(const std::vector<StageObstacle>& obstacles,
-			const Size2d& stageSize);
-		/**
-		 * @brief Checks if a cell with the given `key` exists.
-		 * 
-		 * @details The cell exists iff its center is within the stage bounds
-		 *          and it does not overlap with an obstacle.
-		 */
-		bool isCellAt(const StageGridModel::CellKey& key) const;
-		/**
-		 * @brief Returns the cell with the given `key`.
-		 * 
-		 * @remark UB if `!isCellAt(key)`.
-		 */
-		const StageGridModel::CellValue& at(
-			const StageGridModel::CellKey& key) const;
-		/**
-		 * @brief Returns key of the cell within which's bounds lies the
-		 *        `p` point.
-		 */
-		StageGridModel::CellKey getCellAtPos(const Point_2& p) const;
-	};
 public:
-	friend class Cell;
+	// Index of a cell; the cells are indexed from 0 to `getCellCount() - 1`
+	typedef size_t CellIndex;
+	// Set of the 8 neighbors of a cell
+	typedef uint8_t NeighborMask;
+
 	/**
-	 * @brief Cell of the stage grid model.
+	 * @brief Passability of the grid for a bubble of a particular size.
+	 * 
+	 * @details A bubble fits into a cell iff the squared distance between the
+	 *          cell and the nearest obstacle is greater than the bubble's
+	 *          squared size.
+	 * 
+	 *          The size falls into a bucket. The neighbors which fit a bubble
+	 *          of the bucket's upper bound fit the bubble for sure, the ones
+	 *          which do not fit a bubble of the lower bound do not fit it for
+	 *          sure. Only the rest (few cells near the obstacles) has to be
+	 *          compared with the exact size.
 	 */
-	class Cell {
-	public:
-		friend struct Hash;
-		/**
-		 * @brief Hash function object for the cell.
-		 */
-		struct Hash {
-			size_t operator()(const Cell& key) const {
-				return Point::Hash()(key.m_value.key);
-			}
-		};
+	class Passability {
 	private:
-		const StageGridModel::GridInternal& m_gridInternal;
-		const CellValue& m_value;
-
-		/**
-		 * @brief Returns key of the neighbor cell.
-		 */
-		StageGridModel::CellKey getNeighKey(Direction8 neighDir) const {
-			switch (neighDir) {
-				case DIR8_NONE: return StageGridModel::CellKey(
-					m_value.key.x    , m_value.key.y    );
-				case DIR8_N: return StageGridModel::CellKey(
-					m_value.key.x    , m_value.key.y - 1);
-				case DIR8_NE: return StageGridModel::CellKey(
-					m_value.key.x + 1, m_value.key.y - 1);
-				case DIR8_E: return StageGridModel::CellKey(
-					m_value.key.x + 1, m_value.key.y    );
-				case DIR8_SE: return StageGridModel::CellKey(
-					m_value.key.x + 1, m_value.key.y + 1);
-				case DIR8_S: return StageGridModel::CellKey(
-					m_value.key.x    , m_value.key.y + 1);
-				case DIR8_SW: return StageGridModel::CellKey(
-					m_value.key.x - 1, m_value.key.y + 1);
-				case DIR8_W: return StageGridModel::CellKey(
-					m_value.key.x - 1, m_value.key.y    );
-				case DIR8_NW: return StageGridModel::CellKey(
-					m_value.key.x - 1, m_value.key.y - 1);
-			}
-			assert(((void)"Invalid Direction8 value", false));
-			return StageGridModel::CellKey();
-		}
+		const StageGridModel* m_grid;
+		double m_sqsize;
+		// Neighbors which fit the bucket's upper bound; `nullptr` if the
+		// bucket is unbounded
+		const NeighborMask* m_fitMasks;
+		// Neighbors which fit the bucket's lower bound
+		const NeighborMask* m_mayFitMasks;
 	public:
-		Cell(const StageGridModel::GridInternal& gridInternal,
-			const CellKey& key)
-			: m_gridInternal{gridInternal}
-			, m_value{m_gridInternal.at(key)}
-		{}
-		/**
-		 * @brief Returns the position of the center of the cell.
-		 */
-		Point_2 getPosition() const { return m_value.position; }
+		Passability(const StageGridModel& grid, double sqsize);
 		/**
-		 * @brief Returns the *squared* distance from the nearest obstacle.
+		 * @brief Returns the squared size of the bubble.
 		 */
-		double getNearestObstacleDistance() const {
-			return m_value.nearestObstacleDistance;
-		}
+		double getSqsize() const { return m_sqsize; }
 		/**
-		 * @brief Checks if there is a neighbor cell in the given direction.
+		 * @brief Checks whether the bubble fits into the cell.
 		 */
-		bool hasNeighbor(Direction8 neighDir) const {
-			CellKey neighKey = getNeighKey(neighDir);
-			return m_gridInternal.isCellAt(neighKey);
+		bool fits(CellIndex idx) const {
+			return m_grid->m_nearestObstacleDistances[idx] > m_sqsize;
 		}
 		/**
-		 * @brief Returns the neighbor cell in the given direction.
+		 * @brief Returns the neighbors of the cell the bubble fits into.
 		 */
-		Cell getNeighbor(Direction8 neighDir) const {
-			CellKey neighKey = getNeighKey(neighDir);
-			Cell res(m_gridInternal, neighKey);
+		NeighborMask getNeighborMask(CellIndex idx) const {
+			NeighborMask res = (m_fitMasks != nullptr ? m_fitMasks[idx] : 0);
+			unsigned unsure = m_mayFitMasks[idx] & ~res;
+			for (size_t bit = 0; unsure != 0; ++bit, unsure >>= 1) {
+				if ((unsure & 1) && fits(idx + m_grid->m_neighborOffsets[bit]))
+				{
+					res |= static_cast<NeighborMask>(1u << bit);
+				}
+			}
 			return res;
 		}
-
-		bool operator== (const Cell& rhs) const {
-			return m_value.key == rhs.m_value.key;
-		}
-		bool operator!= (const Cell& rhs) const {
-			return !this->operator==(rhs);
-		}
 	};
 private:
-	GridInternal m_gridInternal;
+	// Cell width/height
+	// It would make sense to keep this value equal to the maximum distance
+	// a player may move by during a single turn. Given the implementation
+	// in the Core it is MAX_SPEED * TICK_INTERVAL (1.0 * 17). Ideally, this
+	// constant should be derived from that instead of having a fixed value,
+	// but at this point I don't even care...
+	static constexpr double CELL_SIZE = 17.0;
+	// Number of raster pixels per cell width/height when measuring the
+	// distances from the obstacles. Odd, so the cell center is a pixel center.
+	static constexpr int RASTER_SUBDIVISION = 7;
+	// The raster pixels are slightly inflated, so a touching obstacle counts
+	// as overlapping even after rounding errors
+	static constexpr double RASTER_EPSILON = 1e-6;
+	// Width of a bubble size bucket (px)
+	static constexpr double PASSABILITY_BUCKET_SIZE = 2.0;
+	// Number of bounded bubble size buckets; the bubbles larger than
+	// `PASSABILITY_BUCKET_SIZE * PASSABILITY_BUCKET_COUNT` fall into the last,
+	// unbounded one
+	static constexpr size_t PASSABILITY_BUCKET_COUNT = 64;
+	// Bit index of a direction; indexed by `dir + 4`. `DIR8_NONE` gets the
+	// extra index 8, which is outside of the `NeighborMask`.
+	static constexpr size_t DIRECTION_BIT_INDICES[] = {
+		5, // DIR8_SW
+		7, // DIR8_NW
+		6, // DIR8_W
+		4, // DIR8_S
+		8, // DIR8_NONE
+		0, // DIR8_N
+		2, // DIR8_E
+		1, // DIR8_NE
+		3, // DIR8_SE
+	};
+
+	// Number of columns and rows
+	const Size2d m_size;
+	// Index difference between a cell and its neighbor; by the direction bit
+	// indices
+	const std::array<std::ptrdiff_t, 9> m_neighborOffsets;
+
+	// Cell properties; by the cell index
+	// Position of the cell center
+	std::vector<Point_2> m_positions;
+	// Squared distance from the nearest obstacle (zero if overlapping)
+	std::vector<double> m_nearestObstacleDistances;
+	// Neighbors which fit a bubble of the size bucket bound; by the bound and
+	// the cell index. The bound 0 are the existing neighbors.
+	std::vector<NeighborMask> m_fitMasks;
+
+	/**
+	 * @brief Creates initial value for the `m_size` variable.
+	 */
+	static Size2d initSize(const Size2d& stageSize);
+	/**
+	 * @brief Creates initial value for the `m_neighborOffsets` variable.
+	 */
+	static std::array<std::ptrdiff_t, 9> initNeighborOffsets(
+		const Size2d& size);
+	/**
+	 * @brief Calculates the position of the cell center.
+	 */
+	static Point_2 getCellPosition(int col, int row);
+	/**
+	 * @brief Calculates the horizontal extent of the part of the obstacle
+	 *        which lies within the horizontal strip `[ymin, ymax]`.
+	 * 
+	 * @return False if no part of the obstacle lies within the strip.
+	 */
+	static bool getStripExtent(const StageObstacle& obstacle, double ymin,
+		double ymax, double& xmin, double& xmax);
+	/**
+	 * @brief Marks the raster pixels which overlap with an obstacle.
+	 * 
+	 * @param occupied The raster (stored by rows). Only the rows
+	 *                 `[rowBegin, rowEnd)` are written.
+	 */
+	void rasterizeObstacles(const std::vector<StageObstacle>& obstacles,
+		std::vector<uint8_t>& occupied, int rowBegin, int rowEnd) const;
+	/**
+	 * @brief Checks whether the cell overlaps with any of the obstacles.
+	 * 
+	 * @param col
+	 * @param row
+	 * @param obstacles The obstacle shapes.
+	 * @param obstacleBboxes Bounding boxes of `obstacles`.
+	 */
+	static bool isCellOverlapping(int col, int row,
+		const std::vector<Triangle_2>& obstacles,
+		const std::vector<CGAL::Bbox_2>& obstacleBboxes);
+	/**
+	 * @brief Calculates the squared distance between the point and the
+	 *        nearest obstacle.
+	 * 
+	 * @param pos
+	 * @param obstacles The obstacle shapes.
+	 * @param obstacleBboxes Bounding boxes of `obstacles`.
+	 * @param maxSqdist Only the obstacles closer than this are measured. The
+	 *                  result is at most `maxSqdist`.
+	 */
+	static double measureNearestObstacleDistance(const Point_2& pos,
+		const std::vector<Triangle_2>& obstacles,
+		const std::vector<CGAL::Bbox_2>& obstacleBboxes, double maxSqdist);
+	/**
+	 * @brief Returns the squared size of the bubble at the bucket bound.
+	 */
+	static double getBucketBoundSqsize(size_t bound);
+	/**
+	 * @brief Returns the bucket of the bubble size.
+	 */
+	static size_t getBucket(double sqsize);
+	/**
+	 * @brief Returns the number of the bucket bounds a cell with the given
+	 *        distance from the nearest obstacle fits.
+	 */
+	static size_t getFitBoundCount(double nearestObstacleDistance);
+
+	/**
+	 * @brief Fills `m_nearestObstacleDistances`.
+	 * 
+	 * @details The obstacles are rasterized to pixels (a pixel is occupied if
+	 *          it overlaps with an obstacle) and the Euclidean distance
+	 *          transform of the raster gives the distance between the cell
+	 *          centers and the nearest occupied pixel. The raster only narrows
+	 *          down the obstacles to check; the distances are exact.
+	 * 
+	 *          A cell with an occupied pixel inside overlaps with an obstacle
+	 *          (the distance is zero then). If only the pixels at the cell
+	 *          border are occupied, the overlap is checked exactly. Otherwise,
+	 *          the nearest obstacle is at most half of the pixel diagonal
+	 *          farther than the nearest occupied pixel, so only the obstacles
+	 *          within this distance are measured.
+	 */
+	void initNearestObstacleDistances(
+		const std::vector<StageObstacle>& obstacles, const Size2d& stageSize,
+		WorkerPool* workerPool);
+	/**
+	 * @brief Fills `m_fitMasks`.
+	 */
+	void initFitMasks();
+	/**
+	 * @brief Returns the neighbor masks of the size bucket bound.
+	 */
+	const NeighborMask* getFitMasks(size_t bound) const;
 public:
+	/**
+	 * @brief Constructs a new StageGridModel object.
+	 * 
+	 * @param obstacles
+	 * @param stageSize
+	 * @param workerPool If not `nullptr`, the model is computed in parallel.
+	 */
 	StageGridModel(const std::vector<StageObstacle>& obstacles,
-		const Size2d& stageSize);
+		const Size2d& stageSize, WorkerPool* workerPool = nullptr);
+
+	/**
+	 * @brief Returns the bit of the direction in a `NeighborMask`.
+	 * 
+	 * @details The bits go clockwise from the north (N is the lowest one).
+	 *          `DIR8_NONE` has no bit.
+	 */
+	static constexpr NeighborMask getDirectionBit(Direction8 dir) {
+		return static_cast<NeighborMask>(
+			(1u << DIRECTION_BIT_INDICES[dir + 4]) & 0xFFu);
+	}
+
+	/**
+	 * @brief Returns the index of the cell within which's bounds lies the `p`
+	 *        point.
+	 * 
+	 * @details The points outside the stage belong to the nearest cell.
+	 */
+	CellIndex getCellIndexAt(const Point_2& p) const;
+	/**
+	 * @brief Returns the number of cells, i.e., the size of an array indexed
+	 *        by the cell indices.
+	 */
+	size_t getCellCount() const;
+	/**
+	 * @brief Returns the position of the center of the cell.
+	 */
+	const Point_2& getPosition(CellIndex idx) const {
+		return m_positions[idx];
+	}
+	/**
+	 * @brief Returns the *squared* distance from the nearest obstacle.
+	 */
+	double getNearestObstacleDistance(CellIndex idx) const {
+		return m_nearestObstacleDistances[idx];
+	}
+	/**
+	 * @brief Returns the existing neighbors of the cell.
+	 * 
+	 * @details The neighbor exists iff its center is within the stage bounds
+	 *          and it does not overlap with an obstacle.
+	 */
+	NeighborMask getNeighborMask(CellIndex idx) const {
+		return m_fitMasks[idx];
+	}
+	/**
+	 * @brief Returns the neighbor cell in the given direction.
+	 * 
+	 * @remark UB if the neighbor is not in the grid. `DIR8_NONE` returns
+	 *         `idx`.
+	 */
+	CellIndex getNeighbor(CellIndex idx, Direction8 dir) const {
+		return idx + m_neighborOffsets[DIRECTION_BIT_INDICES[dir + 4]];
+	}
 	/**
-	 * @brief Returns the cell within which's bounds lies the `p` point.
+	 * @brief Returns the passability of the grid for a bubble.
+	 * 
+	 * @param sqsize Square of the radius of the bubble.
 	 */
-	StageGridModel::Cell getCellAt(const Point_2& p) const;
+	Passability getPassability(double sqsize) const;
 };
 
 #endif // STAGEGRIDMODEL_HPP
@@ -0,0 +1,187 @@
+/**
+ * @file IndexedHeap.hpp
+ * @author Tomáš Ludrovan
+ * @brief IndexedHeap class
+ * @version 0.1
+ * @date 2024-05-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef INDEXEDHEAP_HPP
+#define INDEXEDHEAP_HPP
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Binary min-heap of items identified by indexes, with decrease-key.
+ * 
+ * @details The items are indexes from 0 to `resize()` - 1 (e.g., the cell
+ *          indexes). The position of each item within the heap is tracked,
+ *          so the heap can tell whether it contains an item and lower its key
+ *          in O(log n).
+ * 
+ *          Clearing the heap only visits the items it contains.
+ * 
+ * @tparam Key Key type. The item with the lowest key is at the top.
+ */
+template <typename Key>
+class IndexedHeap {
+public:
+	typedef size_t Item;
+private:
+	// Position of an item which is not in the heap
+	static constexpr size_t NOT_IN_HEAP = static_cast<size_t>(-1);
+
+	struct Entry {
+		Key key;
+		Item item;
+	};
+
+	std::vector<Entry> m_heap;
+	// Position of each item within `m_heap`
+	std::vector<size_t> m_pos;
+
+	void swapEntries(size_t i, size_t j) {
+		std::swap(m_heap[i], m_heap[j]);
+		m_pos[m_heap[i].item] = i;
+		m_pos[m_heap[j].item] = j;
+	}
+	void siftUp(size_t i) {
+		while (i > 0) {
+			size_t parent = (i - 1) / 2;
+			if (!(m_heap[i].key < m_heap[parent].key)) break;
+			swapEntries(i, parent);
+			i = parent;
+		}
+	}
+	void siftDown(size_t i) {
+		while (true) {
+			size_t smallest = i;
+			size_t left = 2*i + 1;
+			size_t right = 2*i + 2;
+			if (left < m_heap.size()
+				&& m_heap[left].key < m_heap[smallest].key)
+			{
+				smallest = left;
+			}
+			if (right < m_heap.size()
+				&& m_heap[right].key < m_heap[smallest].key)
+			{
+				smallest = right;
+			}
+			if (smallest == i) break;
+			swapEntries(i, smallest);
+			i = smallest;
+		}
+	}
+public:
+	/**
+	 * @brief Sets the number of items. Must not be called while the heap is
+	 *        not empty.
+	 */
+	void resize(size_t itemCount) {
+		assert(m_heap.empty());
+		m_pos.assign(itemCount, NOT_IN_HEAP);
+	}
+	/**
+	 * @brief Returns the number of items (in the heap or not).
+	 */
+	size_t getItemCount() const {
+		return m_pos.size();
+	}
+	/**
+	 * @brief Increases the capacity of the heap to a value greater or equal
+	 *        to `n` items.
+	 */
+	void reserve(size_t n) {
+		m_heap.reserve(n);
+	}
+	/**
+	 * @brief Removes all the items from the heap.
+	 */
+	void clear() {
+		for (const auto& entry : m_heap) {
+			m_pos[entry.item] = NOT_IN_HEAP;
+		}
+		m_heap.clear();
+	}
+	/**
+	 * @brief Checks if the heap contains the item.
+	 */
+	bool contains(Item item) const {
+		assert(item < m_pos.size());
+		return m_pos[item] != NOT_IN_HEAP;
+	}
+	/**
+	 * @brief Returns the key of an item in the heap.
+	 */
+	const Key& getKey(Item item) const {
+		assert(contains(item));
+		return m_heap[m_pos[item]].key;
+	}
+	/**
+	 * @brief Inserts an item which is not in the heap yet.
+	 */
+	void push(Item item, const Key& key) {
+		assert(!contains(item));
+		m_pos[item] = m_heap.size();
+		m_heap.push_back(Entry{key, item});
+		siftUp(m_heap.size() - 1);
+	}
+	/**
+	 * @brief Lowers the key of an item in the heap.
+	 * 
+	 * @remark `key` must not be greater than the current key.
+	 */
+	void decreaseKey(Item item, const Key& key) {
+		assert(contains(item));
+		assert(!(getKey(item) < key));
+		size_t i = m_pos[item];
+		m_heap[i].key = key;
+		siftUp(i);
+	}
+	/**
+	 * @brief Returns the item with the lowest key.
+	 */
+	Item top() const {
+		assert(!empty());
+		return m_heap.front().item;
+	}
+	/**
+	 * @brief Returns the lowest key.
+	 */
+	const Key& topKey() const {
+		assert(!empty());
+		return m_heap.front().key;
+	}
+	/**
+	 * @brief Removes the item with the lowest key.
+	 */
+	void pop() {
+		assert(!empty());
+		swapEntries(0, m_heap.size() - 1);
+		m_pos[m_heap.back().item] = NOT_IN_HEAP;
+		m_heap.pop_back();
+		if (!m_heap.empty()) {
+			siftDown(0);
+		}
+	}
+	/**
+	 * @brief Returns the number of items in the heap.
+	 */
+	size_t size() const {
+		return m_heap.size();
+	}
+	/**
+	 * @brief Checks whether the heap is empty.
+	 */
+	bool empty() const {
+		return m_heap.empty();
+	}
+};
+
+#endif // INDEXEDHEAP_HPP
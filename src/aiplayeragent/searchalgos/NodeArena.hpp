@@ -0,0 +1,104 @@
+/**
+ * @file NodeArena.hpp
+ * @author Tomáš Ludrovan
+ * @brief NodeArena class
+ * @version 0.1
+ * @date 2024-05-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef NODEARENA_HPP
+#define NODEARENA_HPP
+
+#include <cassert>
+#include <vector>
+
+/**
+ * @brief Storage of the nodes of a search tree.
+ * 
+ * @details The nodes are referred to by their indexes (e.g., the parent of
+ *          a node), which stay valid until the arena is reset. Resetting the
+ *          arena keeps its memory, so a search does not allocate once the
+ *          arena has grown large enough.
+ * 
+ *          The most recently added node may also be removed, so the arena may
+ *          serve as the stack of a depth-first search.
+ * 
+ * @tparam Node Node type.
+ */
+template <typename Node>
+class NodeArena {
+public:
+	typedef size_t NodeIdx;
+
+	// Index of no node (e.g., the parent of the root)
+	static constexpr NodeIdx NO_NODE = static_cast<NodeIdx>(-1);
+private:
+	std::vector<Node> m_nodes;
+public:
+	/**
+	 * @brief Removes all the nodes (keeps the memory).
+	 */
+	void reset() {
+		m_nodes.clear();
+	}
+	/**
+	 * @brief Increases the capacity of the arena to a value greater or equal
+	 *        to `n` nodes.
+	 */
+	void reserve(size_t n) {
+		m_nodes.reserve(n);
+	}
+	/**
+	 * @brief Adds a node and returns its index.
+	 */
+	NodeIdx add(const Node& node) {
+		m_nodes.push_back(node);
+		return m_nodes.size() - 1;
+	}
+	/**
+	 * @brief Removes the most recently added node.
+	 */
+	void pop() {
+		assert(!m_nodes.empty());
+		m_nodes.pop_back();
+	}
+	/**
+	 * @brief Returns the most recently added node.
+	 */
+	Node& back() {
+		assert(!m_nodes.empty());
+		return m_nodes.back();
+	}
+	/**
+	 * @brief Returns the most recently added node.
+	 */
+	const Node& back() const {
+		assert(!m_nodes.empty());
+		return m_nodes.back();
+	}
+	Node& operator[](NodeIdx idx) {
+		assert(idx < m_nodes.size());
+		return m_nodes[idx];
+	}
+	const Node& operator[](NodeIdx idx) const {
+		assert(idx < m_nodes.size());
+		return m_nodes[idx];
+	}
+	/**
+	 * @brief Returns the number of nodes.
+	 */
+	size_t size() const {
+		return m_nodes.size();
+	}
+	/**
+	 * @brief Checks whether the arena has no nodes.
+	 */
+	bool empty() const {
+		return m_nodes.empty();
+	}
+};
+
+#endif // NODEARENA_HPP
@@ -0,0 +1,105 @@
+/**
+ * @file StampedArray.hpp
+ * @author Tomáš Ludrovan
+ * @brief StampedArray class
+ * @version 0.1
+ * @date 2024-05-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef STAMPEDARRAY_HPP
+#define STAMPEDARRAY_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Array of optional values which can be cleared in constant time.
+ * 
+ * @details Each value is stamped with the generation it was set in. Only the
+ *          values of the current generation are set, so clearing the array is
+ *          just starting a new generation. Useful for the visited flags or
+ *          the g-values of a search, indexed by the cell indexes.
+ * 
+ * @tparam T Value type.
+ */
+template <typename T>
+class StampedArray {
+	// `std::vector<bool>` does not return references to its values
+	static_assert(!std::is_same<T, bool>::value,
+		"StampedArray<bool> is not supported");
+private:
+	typedef uint32_t Stamp;
+
+	std::vector<T> m_values;
+	// Generation in which the value has been set
+	std::vector<Stamp> m_stamps;
+	// Current generation (never 0, which is the stamp of a new value)
+	Stamp m_stamp;
+public:
+	StampedArray()
+		: m_stamp{1}
+	{}
+	/**
+	 * @brief Changes the number of the values. The new values are not set.
+	 */
+	void resize(size_t n) {
+		m_values.resize(n);
+		m_stamps.resize(n, 0);
+	}
+	/**
+	 * @brief Returns the number of the values (set or not).
+	 */
+	size_t size() const {
+		return m_values.size();
+	}
+	/**
+	 * @brief Unsets all the values.
+	 */
+	void clear() {
+		m_stamp++;
+		if (m_stamp == 0) {
+			// Wrapped around -- the old stamps could be taken as current
+			std::fill(m_stamps.begin(), m_stamps.end(), 0);
+			m_stamp = 1;
+		}
+	}
+	/**
+	 * @brief Checks whether the value at `idx` is set.
+	 */
+	bool contains(size_t idx) const {
+		assert(idx < m_stamps.size());
+		return m_stamps[idx] == m_stamp;
+	}
+	/**
+	 * @brief Returns the value at `idx`.
+	 * 
+	 * @remark The value must be set.
+	 */
+	const T& get(size_t idx) const {
+		assert(contains(idx));
+		return m_values[idx];
+	}
+	/**
+	 * @brief Sets the value at `idx`.
+	 */
+	void set(size_t idx, const T& value) {
+		assert(idx < m_values.size());
+		m_values[idx] = value;
+		m_stamps[idx] = m_stamp;
+	}
+	/**
+	 * @brief Unsets the value at `idx`.
+	 */
+	void erase(size_t idx) {
+		assert(idx < m_stamps.size());
+		m_stamps[idx] = m_stamp - 1;
+	}
+};
+
+#endif // STAMPEDARRAY_HPP
@@ -0,0 +1,192 @@
+/**
+ * @file test.cpp
+ * @author Tomáš Ludrovan
+ * @brief Test suite for the search containers.
+ * @version 0.1
+ * @date 2024-05-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "IndexedHeap.hpp"
+#include "NodeArena.hpp"
+#include "StampedArray.hpp"
+
+// You might want to disable this if your terminal does not support
+// ANSI escape codes.
+#define ENABLE_COLORED_OUTPUT
+
+#ifdef ENABLE_COLORED_OUTPUT
+#	define BEGIN_FAILED_TEXT "\x1B[31m"  // Red
+#	define BEGIN_PASSED_TEXT "\x1B[32m"  // Green
+#	define RESET_TEXT "\x1B[0m"          // Default
+#else // !ENABLE_COLORED_OUTPUT
+#	define BEGIN_FAILED_TEXT
+#	define BEGIN_PASSED_TEXT
+#	define RESET_TEXT
+#endif // !ENABLE_COLORED_OUTPUT
+
+/**
+ * @brief Pops all the items of the heap.
+ */
+template <typename Key>
+std::vector<size_t> popAll(IndexedHeap<Key>& h)
+{
+	std::vector<size_t> res;
+	while (!h.empty()) {
+		res.push_back(h.top());
+		h.pop();
+	}
+	return res;
+}
+
+/**
+ * @brief Test case setup.
+ * 
+ * @details `testName` is a `const char*` value identifying the test case.
+ */
+#define BEGIN_TEST(testName) try { \
+	std::cout << testName << std::endl;
+
+/**
+ * @brief Test case verify and teardown.
+ * 
+ * @details `isPassed` is a boolean rvalue which identifies the result of test
+ *          case.
+ */
+#define END_TEST(isPassed)                                         \
+	std::cout << ((isPassed)                                       \
+			? BEGIN_PASSED_TEXT "Passed" RESET_TEXT                \
+			: BEGIN_FAILED_TEXT "Failed" RESET_TEXT)               \
+		<< std::endl;                                              \
+	if (isPassed) ++passCount;                                     \
+	++testCount;                                                   \
+} catch (...) {                                                    \
+	std::cout << BEGIN_FAILED_TEXT "Failed (exception)" RESET_TEXT \
+		<< std::endl;                                              \
+	++testCount;                                                   \
+}
+
+
+int main()
+{
+	int passCount = 0, testCount = 0;
+
+	BEGIN_TEST("Heap empty")
+		IndexedHeap<double> h;
+		h.resize(10);
+	END_TEST(h.empty() && h.size() == 0 && !h.contains(3))
+
+	BEGIN_TEST("Heap order")
+		IndexedHeap<double> h;
+		h.resize(10);
+		h.push(4, 4.0);
+		h.push(7, 1.0);
+		h.push(2, 3.0);
+		h.push(9, 2.0);
+		bool isContained = h.contains(4) && h.contains(9) && !h.contains(5);
+		auto items = popAll(h);
+	END_TEST(isContained && items == std::vector<size_t>({7, 9, 2, 4})
+		&& !h.contains(4))
+
+	BEGIN_TEST("Heap decrease key")
+		IndexedHeap<double> h;
+		h.resize(10);
+		h.push(4, 4.0);
+		h.push(7, 1.0);
+		h.push(2, 3.0);
+		h.decreaseKey(4, 0.5);
+		bool isKeyChanged = (h.getKey(4) == 0.5);
+		auto items = popAll(h);
+	END_TEST(isKeyChanged && items == std::vector<size_t>({4, 7, 2}))
+
+	BEGIN_TEST("Heap clear")
+		IndexedHeap<double> h;
+		h.resize(10);
+		h.push(4, 4.0);
+		h.push(7, 1.0);
+		h.clear();
+		bool isCleared = h.empty() && !h.contains(4) && !h.contains(7);
+		h.push(7, 2.0);
+	END_TEST(isCleared && h.size() == 1 && h.top() == 7)
+
+	BEGIN_TEST("Heap random")
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<double> dist(0.0, 100.0);
+		const size_t N = 1000;
+		IndexedHeap<double> h;
+		h.resize(N);
+		std::vector<double> keys(N);
+		for (size_t i = 0; i < N; i++) {
+			keys[i] = dist(rng);
+			h.push(i, keys[i]);
+		}
+		for (size_t i = 0; i < N; i += 3) {
+			keys[i] /= 2.0;
+			h.decreaseKey(i, keys[i]);
+		}
+		std::vector<double> popped;
+		while (!h.empty()) {
+			popped.push_back(h.topKey());
+			h.pop();
+		}
+		std::sort(keys.begin(), keys.end());
+	END_TEST(popped == keys)
+
+	BEGIN_TEST("Stamped array empty")
+		StampedArray<int> a;
+		a.resize(5);
+	END_TEST(a.size() == 5 && !a.contains(0) && !a.contains(4))
+
+	BEGIN_TEST("Stamped array set")
+		StampedArray<int> a;
+		a.resize(5);
+		a.set(2, 7);
+		a.set(3, 8);
+		a.erase(3);
+	END_TEST(a.contains(2) && a.get(2) == 7 && !a.contains(3))
+
+	BEGIN_TEST("Stamped array clear")
+		StampedArray<int> a;
+		a.resize(5);
+		a.set(2, 7);
+		a.clear();
+		bool isCleared = !a.contains(2);
+		a.set(1, 3);
+	END_TEST(isCleared && a.contains(1) && !a.contains(2))
+
+	BEGIN_TEST("Stamped array resize")
+		StampedArray<int> a;
+		a.resize(2);
+		a.set(1, 3);
+		a.resize(4);
+	END_TEST(a.contains(1) && !a.contains(2) && !a.contains(3))
+
+	BEGIN_TEST("Arena add")
+		NodeArena<int> arena;
+		auto i1 = arena.add(5);
+		auto i2 = arena.add(6);
+	END_TEST(arena.size() == 2 && arena[i1] == 5 && arena[i2] == 6)
+
+	BEGIN_TEST("Arena stack")
+		NodeArena<int> arena;
+		arena.add(5);
+		arena.add(6);
+		arena.pop();
+	END_TEST(arena.size() == 1 && arena.back() == 5)
+
+	BEGIN_TEST("Arena reset")
+		NodeArena<int> arena;
+		arena.add(5);
+		arena.reset();
+		auto i = arena.add(6);
+	END_TEST(arena.size() == 1 && i == 0 && arena[i] == 6)
+
+	std::cout << "Result: " << passCount << "/" << testCount << std::endl;
+}
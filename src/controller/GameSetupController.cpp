@@ -11,6 +11,8 @@
 
 #include "controller/GameSetupController.hpp"
 
+#include <random>
+
 #include "imgui.h"
 
 #include "aiplayeragent/AIPlayerAgentFactory.hpp"
@@ -23,6 +25,13 @@ void GameSetupController::updateGsdata()
 	assert(m_gsdataInternal.isStageIdValid);
 
 	m_gsdata.stage = m_gsdataInternal.stage;
+	m_gsdata.stageId = m_loadedStageId;
+	// Keep the last match for reproducing problems offline
+	m_gsdata.recordPath = LAST_MATCH_REPLAY_PATH;
+	// ...but do not refuse to play if it cannot be written
+	m_gsdata.isRecordingOptional = true;
+	// Every game is different
+	m_gsdata.seed = std::random_device{}();
 
 	std::shared_ptr<IAIPlayerAgent> botAgent;
 
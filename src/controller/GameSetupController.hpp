@@ -27,6 +27,8 @@ class GameSetupController : public GeneralControllerBase {
 private:
 	// We don't even have colors for more players than this
 	static constexpr int MAX_PLAYERS = 8;
+	// Every match is recorded here (overwriting the previous one)
+	static constexpr const char* LAST_MATCH_REPLAY_PATH = "last_match.rpl";
 
 	enum PlayerSpecies {
 		PLAYER_HUMAN,
@@ -11,7 +11,9 @@
 
 #include "controller/InGameController.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <thread>
 
 #include "controller/ControllerFactory.hpp"
 #include "core/Core.hpp"
@@ -26,9 +28,24 @@ static constexpr const char* BENCH_ID_ON_PAINT = "ingame-on-paint";
 InGameController::InGameController(std::shared_ptr<ISysProxy> sysProxy,
 	const GameSetupData& gsdata)
 	: GeneralControllerBase(sysProxy)
-	, m_core{std::make_unique<Core>(gsdata)}
+	, m_core{std::make_unique<Core>(createCoreSetup(gsdata))}
 {}
 
+GameSetupData InGameController::createCoreSetup(const GameSetupData& gsdata)
+{
+	GameSetupData res = gsdata;
+	// The HP is shown as an integer
+	res.playerEventSteps.hp = 1.0 / PLAYER_HP_FACTOR;
+	// The agents plan (and the ticks are computed) on the other cores
+	res.tickWorkerCount = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+	// Each agent gets its share of the tick (17 ms / 8 players)
+	res.agentPlanBudget = 2.0;
+	// Rather play with slower AI than stutter
+	res.degradationPolicy.maxSkippedAgents = 2;
+	res.degradationPolicy.overloadMaxCatchUp = 1;
+	return res;
+}
+
 void InGameController::createPlayerSprite(PlayerId id)
 {
 	auto playerSprite = std::make_unique<PlayerSprite>(sysProxy);
@@ -226,186 +243,83 @@ void InGameController::updateHpRecoverySprites()
 	}
 }
 
-void InGameController::updateSpritesByAction(
-	const std::shared_ptr<CoreAction> action)
-{
-	switch (action->getType()) {
-		case CoreAction::ACTION_NONE:
-			updateSpritesByActionNone(action);
-			break;
-		case CoreAction::ACTION_MULTIPLE:
-			updateSpritesByActionMultiple(action);
-			break;
-		case CoreAction::ACTION_ADD_OBSTACLE:
-			updateSpritesByActionAddObstacle(action);
-			break;
-		case CoreAction::ACTION_SET_STAGE_SIZE:
-			updateSpritesByActionSetStageSize(action);
-			break;
-		case CoreAction::ACTION_ADD_PLAYER:
-			updateSpritesByActionAddPlayer(action);
-			break;
-		case CoreAction::ACTION_REMOVE_PLAYER:
-			updateSpritesByActionRemovePlayer(action);
-			break;
-		case CoreAction::ACTION_SET_PLAYER_POS:
-			updateSpritesByActionSetPlayerPos(action);
-			break;
-		case CoreAction::ACTION_SET_PLAYER_HP:
-			updateSpritesByActionSetPlayerHp(action);
-			break;
-		case CoreAction::ACTION_SET_PLAYER_SIZE:
-			updateSpritesByActionSetPlayerSize(action);
-			break;
-		case CoreAction::ACTION_ADD_BONUS:
-			updateSpritesByActionAddBonus(action);
-			break;
-		case CoreAction::ACTION_REMOVE_BONUS:
-			updateSpritesByActionRemoveBonus(action);
-			break;
-		case CoreAction::ACTION_ANNOUNCE_WINNER:
-			updateSpritesByActionAnnounceWinner(action);
-			break;
-		case CoreAction::ACTION_ANNOUNCE_DRAW_GAME:
-			updateSpritesByActionAnnounceDrawGame(action);
-			break;
-	}
-}
-
-void InGameController::updateSpritesByActionNone(
-	const std::shared_ptr<CoreAction> action)
-{
-	(void)action;
-	// Nothing to do
-}
-
-void InGameController::updateSpritesByActionMultiple(
-	const std::shared_ptr<CoreAction> action)
+void InGameController::onAddObstacle(const PolygonF& shape)
 {
-	const auto actionCast =
-		std::dynamic_pointer_cast<CoreActionMultiple>(action);
-	
-	for (const auto& a : actionCast->getActions()) {
-		updateSpritesByAction(a);
-	}
+	createObstacleSprite(shape);
 }
 
-void InGameController::updateSpritesByActionAddObstacle(
-	const std::shared_ptr<CoreAction> action)
+void InGameController::onSetStageSize(const Size2d& size)
 {
-	const auto actionCast =
-		std::dynamic_pointer_cast<CoreActionAddObstacle>(action);
-
-	createObstacleSprite(actionCast->getShape());
-}
-
-void InGameController::updateSpritesByActionSetStageSize(
-	const std::shared_ptr<CoreAction> action)
-{
-	const auto actionCast =
-		std::dynamic_pointer_cast<CoreActionSetStageSize>(action);
-
-	Rect stageRect(0, 0, actionCast->getSize());
+	Rect stageRect(0, 0, size);
 	RectF holeF = m_viewport->stageToScreen(static_cast<RectF>(stageRect));
 	Rect hole = static_cast<Rect>(holeF);
 	m_stageBoundsSprite->setHole(hole);
 }
 
-void InGameController::updateSpritesByActionAddPlayer(
-	const std::shared_ptr<CoreAction> action)
+void InGameController::onAddPlayer(PlayerId id)
 {
-	const auto actionCast =
-		std::dynamic_pointer_cast<CoreActionAddPlayer>(action);
-
-	createPlayerSprite(actionCast->getId());
-	createPlayerHpBgSprite(actionCast->getId());
-	createPlayerHpTextSprite(actionCast->getId());
+	createPlayerSprite(id);
+	createPlayerHpBgSprite(id);
+	createPlayerHpTextSprite(id);
 }
 
-void InGameController::updateSpritesByActionRemovePlayer(
-	const std::shared_ptr<CoreAction> action)
+void InGameController::onRemovePlayer(PlayerId id)
 {
-	const auto actionCast =
-		std::dynamic_pointer_cast<CoreActionRemovePlayer>(action);
-	
-	PlayerId id = actionCast->getId();
-
 	m_playerSprites.erase(id);
 	m_playerHpBgSprites.erase(id);
 	m_playerHpTextSprites.erase(id);
 }
 
-void InGameController::updateSpritesByActionSetPlayerPos(
-	const std::shared_ptr<CoreAction> action)
+void InGameController::onSetPlayerPos(PlayerId id, const PointF& pos)
 {
-	const auto actionCast =
-		std::dynamic_pointer_cast<CoreActionSetPlayerPos>(action);
-
-	updatePlayerPos(actionCast->getId(), actionCast->getPos());
+	updatePlayerPos(id, pos);
 }
 
-void InGameController::updateSpritesByActionSetPlayerHp(
-	const std::shared_ptr<CoreAction> action)
+void InGameController::onSetPlayerHp(PlayerId id, double hp)
 {
-	const auto actionCast =
-		std::dynamic_pointer_cast<CoreActionSetPlayerHp>(action);
-
-	updatePlayerHp(actionCast->getId(), actionCast->getHp());
+	updatePlayerHp(id, hp);
 }
 
-void InGameController::updateSpritesByActionSetPlayerSize(
-	const std::shared_ptr<CoreAction> action)
+void InGameController::onSetPlayerSize(PlayerId id, double size)
 {
-	const auto actionCast =
-		std::dynamic_pointer_cast<CoreActionSetPlayerSize>(action);
-	
-	updatePlayerSize(actionCast->getId(), actionCast->getSize());
+	updatePlayerSize(id, size);
 }
 
-void InGameController::updateSpritesByActionAddBonus(
-	const std::shared_ptr<CoreAction> action)
+void InGameController::onAddBonus(BonusId id, const PointF& pos)
 {
-	const auto actionCast =
-		std::dynamic_pointer_cast<CoreActionAddBonus>(action);
-	
-	createBonusSprite(actionCast->getId(), actionCast->getPos());
+	createBonusSprite(id, pos);
 }
 
-void InGameController::updateSpritesByActionRemoveBonus(
-	const std::shared_ptr<CoreAction> action)
+void InGameController::onRemoveBonus(BonusId id, double hpRecovery,
+	bool isCollected)
 {
-	const auto actionCast =
-		std::dynamic_pointer_cast<CoreActionRemoveBonus>(action);
-	
-	// Find the collected bonus sprite
-	auto bonusSprIter = m_bonusSprites.find(actionCast->getId());
-
-	// Create the HP recovery sprite
-	auto recovSpr = std::make_unique<BonusHpRecoverySprite>(sysProxy);
-	recovSpr->setBonusRect(bonusSprIter->second->getBounds());
-	double hpRecoveryF = actionCast->getHpRecovery() * PLAYER_HP_FACTOR;
-	recovSpr->setHpRecovery(static_cast<int>(hpRecoveryF));
-	recovSpr->startAnimation();
-	// ... and insert it to the set
-	m_bonusHpRecoverySprites.insert(std::move(recovSpr));
+	// Find the removed bonus sprite
+	auto bonusSprIter = m_bonusSprites.find(id);
+
+	if (isCollected) {
+		// Create the HP recovery sprite
+		auto recovSpr = std::make_unique<BonusHpRecoverySprite>(sysProxy);
+		recovSpr->setBonusRect(bonusSprIter->second->getBounds());
+		double hpRecoveryF = hpRecovery * PLAYER_HP_FACTOR;
+		recovSpr->setHpRecovery(static_cast<int>(hpRecoveryF));
+		recovSpr->startAnimation();
+		// ... and insert it to the set
+		m_bonusHpRecoverySprites.insert(std::move(recovSpr));
+	}
 
 	// Delete the collected bonus sprite
 	m_bonusSprites.erase(bonusSprIter);
 }
 
-void InGameController::updateSpritesByActionAnnounceWinner(
-	const std::shared_ptr<CoreAction> action)
+void InGameController::onAnnounceWinner(PlayerId id)
 {
-	(void)action;
+	(void)id;
 
 	m_gameOverTextSprite->setText(GAME_OVER_TEXT_WINNER);
 }
 
-void InGameController::updateSpritesByActionAnnounceDrawGame(
-	const std::shared_ptr<CoreAction> action)
+void InGameController::onAnnounceDrawGame()
 {
-	(void)action;
-
 	m_gameOverTextSprite->setText(GAME_OVER_TEXT_DRAW_GAME);
 }
 
@@ -481,8 +395,7 @@ void InGameController::onStarted()
 	createSprites();
 
 	// This will initialize the core
-	auto action = m_core->loopEvent();
-	updateSpritesByAction(action);
+	m_core->loopEvent().visit(*this);
 }
 
 void InGameController::onFinished()
@@ -494,8 +407,7 @@ void InGameController::onLoop()
 {
 	updateHpRecoverySprites();
 
-	auto action = m_core->loopEvent();
-	updateSpritesByAction(action);
+	m_core->loopEvent().visit(*this);
 }
 
 void InGameController::onMouseMove(int x, int y)
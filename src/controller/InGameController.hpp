@@ -22,7 +22,7 @@
 #include "controller/GeneralControllerBase.hpp"
 #include "core/Common.hpp"
 #include "core/Core.hpp"
-#include "core/CoreAction.hpp"
+#include "core/coreevent/CoreEvent.hpp"
 #include "gamesetupdata/GameSetupData.hpp"
 #include "sprite/PlayerSprite.hpp"
 #include "sprite/ObstacleSprite.hpp"
@@ -34,7 +34,8 @@
 #include "sprite/TextSprite.hpp"
 #include "stageviewport/StageViewport.hpp"
 
-class InGameController : public GeneralControllerBase {
+class InGameController : public GeneralControllerBase,
+	public ICoreEventVisitor {
 private:
 	// Internally, full HP is equal to `1.0`. Externally (as shown to the user),
 	// full HP is equal to `100.0`.
@@ -102,36 +103,27 @@ private:
 
 	void updateHpRecoverySprites();
 
-	void updateSpritesByAction(
-		const std::shared_ptr<CoreAction> action);
-	void updateSpritesByActionNone(
-		const std::shared_ptr<CoreAction> action);
-	void updateSpritesByActionMultiple(
-		const std::shared_ptr<CoreAction> action);
-	void updateSpritesByActionAddObstacle(
-		const std::shared_ptr<CoreAction> action);
-	void updateSpritesByActionSetStageSize(
-		const std::shared_ptr<CoreAction> action);
-	void updateSpritesByActionAddPlayer(
-		const std::shared_ptr<CoreAction> action);
-	void updateSpritesByActionRemovePlayer(
-		const std::shared_ptr<CoreAction> action);
-	void updateSpritesByActionSetPlayerPos(
-		const std::shared_ptr<CoreAction> action);
-	void updateSpritesByActionSetPlayerHp(
-		const std::shared_ptr<CoreAction> action);
-	void updateSpritesByActionSetPlayerSize(
-		const std::shared_ptr<CoreAction> action);
-	void updateSpritesByActionAddBonus(
-		const std::shared_ptr<CoreAction> action);
-	void updateSpritesByActionRemoveBonus(
-		const std::shared_ptr<CoreAction> action);
-	void updateSpritesByActionAnnounceWinner(
-		const std::shared_ptr<CoreAction> action);
-	void updateSpritesByActionAnnounceDrawGame(
-		const std::shared_ptr<CoreAction> action);
+	void onAddObstacle(const PolygonF& shape) override;
+	void onSetStageSize(const Size2d& size) override;
+	void onAddPlayer(PlayerId id) override;
+	void onRemovePlayer(PlayerId id) override;
+	void onSetPlayerPos(PlayerId id, const PointF& pos) override;
+	void onSetPlayerHp(PlayerId id, double hp) override;
+	void onSetPlayerSize(PlayerId id, double size) override;
+	void onAddBonus(BonusId id, const PointF& pos) override;
+	void onRemoveBonus(BonusId id, double hpRecovery, bool isCollected)
+		override;
+	void onAnnounceWinner(PlayerId id) override;
+	void onAnnounceDrawGame() override;
 
 	void initializeViewport();
+	/**
+	 * @brief Adjusts the setup for the core driving this controller.
+	 * 
+	 * @details The core does not report the changes which would not be
+	 *          visible.
+	 */
+	static GameSetupData createCoreSetup(const GameSetupData& gsdata);
 
 	Rect getStageAreaRect();
 	Rect getPlayerHpBarRect(PlayerId playerId);
@@ -30,6 +30,22 @@ constexpr BonusId BONUS_ID_NULL = 0;
  */
 constexpr std::clock_t TICK_INTERVAL = 17;
 
+/**
+ * @brief The maximum number of ticks executed during one event loop iteration.
+ * 
+ * @details If the game falls behind the real time more than this, the
+ *          remaining ticks are dropped.
+ */
+constexpr unsigned MAX_CATCH_UP_TICKS = 4;
+
 constexpr double BONUS_RADIUS = 25.0;
 
+/**
+ * @brief Collision of a player with another player during a tick.
+ */
+struct PlayerCollision {
+	PlayerId opponentId;
+	double opponentStrength;
+};
+
 #endif // CORE_COMMON_HPP
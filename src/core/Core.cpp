@@ -11,9 +11,18 @@
 
 #include "core/Core.hpp"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
 #include "functions.hpp"
 #include "core/trajectory/Trajectory.hpp"
 #include "math/Math.hpp"
+#include "replay/ReplayReader.hpp"
 
 #ifdef INCLUDE_BENCHMARK
 #include "utilities/benchmark/Benchmark.hpp"
@@ -22,192 +31,217 @@ static constexpr const char* BENCH_ID_PL_ACTIONS = "core-pl-actions";
 static constexpr const char* BENCH_ID_UPDATE_GSPROXY = "core-update-gsproxy";
 #endif // INCLUDE_BENCHMARK
 
+/**
+ * @brief Splits the seed into 32-bit words (low first).
+ * 
+ * @details `std::seed_seq` keeps only the lowest 32 bits of each value.
+ */
+static std::array<uint32_t, 2> splitSeed(RNGSeedType seed)
+{
+	auto value = static_cast<uint64_t>(seed);
+	return {
+		static_cast<uint32_t>(value & 0xffffffffu),
+		static_cast<uint32_t>(value >> 32),
+	};
+}
+
 Core::Core(const GameSetupData& gsdata)
 	: m_isInitialized{false}
 	, m_isOver{false}
 	, m_gsdata{gsdata}
-	, m_tickTimer(TICK_INTERVAL)
-	, m_bonusTimer{createNewBonusTimer()}
+	, m_tickCount{0}
+	, m_rng(gsdata.seed)
+	, m_tickScheduler(TICK_INTERVAL, MAX_CATCH_UP_TICKS)
+	, m_profiler(TICK_INTERVAL)
+	, m_watchdog(TICK_INTERVAL, gsdata.degradationPolicy, MAX_CATCH_UP_TICKS)
+	, m_bonusCountdown{createNewBonusCountdown()}
 {
-	assert(gsdata.players.size() <= gsdata.stage->getPlayers().size());
-}
+	assert(gsdata.replay == nullptr
+		|| gsdata.replay->getPlayerCount() == gsdata.players.size());
 
-CoreActionPtr Core::initTurnData(TurnData& turnData)
-{
-	turnData.playerTurns.reserve(m_players.size());
-	
-	for (auto& [id, state] : m_players) {
-		turnData.playerTurns[id] = PlayerTurn{
-			&state, // playerRef
-#ifndef OLD_TRAJECTORY_ALGORITHM
-			Trajectory(state.pos), // trajectory
-#else
-			Trajectory(), // trajectory
-#endif
-			std::vector<PlayerCollision>(), // playerCollisions
-			std::vector<BonusCollision>(), // bonusCollisions
-			EffectAttributes(), // effectAttributes
-		};
+	if (gsdata.tickWorkerCount > 0) {
+		m_workerPool = std::make_unique<WorkerPool>(gsdata.tickWorkerCount);
 	}
 
-	return std::make_shared<CoreActionNone>();
+	m_planAgentsJob = [this](size_t chunk, size_t begin, size_t end) {
+		(void)chunk;
+		planAgents(begin, end);
+	};
 }
 
-CoreActionPtr Core::applyPlayerEffects(TurnData& turnData)
+Core::Core(const GameSetupData& gsdata, const Core& source)
+	: Core(gsdata)
 {
-	for (auto& [id, turn] : turnData.playerTurns) {
-		auto& player = *turn.playerRef;
+	assert(source.m_isInitialized);
+	assert(gsdata.players.size() == source.m_gsdata.players.size());
+	assert(gsdata.replay == nullptr && gsdata.recordPath.empty());
 
-		// For each active bonus effect...
-		auto iter = player.bonusEffects.begin();
-		while (iter != player.bonusEffects.end()) {
-			// Access the effect object through iterator
-			auto& effect = *iter;
-			
-			// Apply
-			effect->applyEffect(turn.effectAttributes);
+	// Share the static stage data
+	m_stageObstacles = source.m_stageObstacles;
+	m_stageGridModel = source.m_stageGridModel;
+	m_stageBonuses = std::make_unique<StageBonuses>(*source.m_stageBonuses);
 
-			if (effect->isActive()) {
-				// Still active -- move on to the next one
+	initializeStage();
 
-				iter++;
-			} else {
-				// The effect has run out -- erase it and then move on to the
-				// next one
+	Snapshot snapshot;
+	source.saveSnapshot(snapshot);
+	restoreSnapshot(snapshot);
 
-				// Note: `erase()` returns the iterator following the removed
-				// element
-				iter = player.bonusEffects.erase(iter);
-			}
+	// The branch continues the game, there is nothing to announce
+	m_events.clear();
+}
+
+Core::~Core()
+{
+	joinAgents();
+}
+
+void Core::readPlayerInputs(TurnData& turnData)
+{
+	(void)turnData;
+
+	if (m_gsdata.replay != nullptr) {
+		// Replay
+
+		if (!m_gsdata.replay->readTick(m_players.inputFlags)) {
+			// The replay has ended -- nobody moves anymore
+			std::fill(m_players.inputFlags.begin(), m_players.inputFlags.end(),
+				PlayerInputFlags());
+		}
+	} else {
+		for (PlayerId id : m_players.alive) {
+			m_players.inputFlags[id] = m_players.input[id]->readInput();
 		}
 	}
 
-	return std::make_shared<CoreActionNone>();
+	if (m_inputRecorder != nullptr) {
+		m_inputRecorder->writeTick(m_players.inputFlags);
+	}
 }
 
-CoreActionPtr Core::calculateTrajectories(TurnData& turnData)
+void Core::initTurnData(TurnData& turnData)
 {
-	double vx, vy;
-	Point_2 source;
-	Vector_2 v;
+	// The buffers of the previous tick are reused
+	turnData.playerTurns.resize(m_players.pos.size());
+	turnData.effectAttributes.assign(m_players.pos.size(), EffectAttributes());
+	turnData.collectedBonuses.clear();
 	
-	for (auto& [id, playerTurn] : turnData.playerTurns) {
+	for (PlayerId id : m_players.alive) {
+		auto& turn = turnData.playerTurns[id];
+
+#ifndef OLD_TRAJECTORY_ALGORITHM
+		turn.trajectory = Trajectory(m_players.pos[id]);
+#else
+		turn.trajectory = Trajectory();
+#endif
+		turn.playerCollisions.clear();
+		turn.bonusCollisions.clear();
+	}
+}
+
+void Core::applyPlayerEffects(TurnData& turnData)
+{
+	// All the effects of a kind are applied at once
+	m_bonusEffects.applyEffects(turnData.effectAttributes);
+}
+
+void Core::calculateTrajectories(TurnData& turnData)
+{
+	// The obstacle queries are read-only
+	forEachAlivePlayer([this, &turnData](PlayerId id) {
+		auto& playerTurn = turnData.playerTurns[id];
+		double vx, vy;
 
 		getPlayerMovementVector(id, vx, vy);
-		source = m_players[id].pos;
-		v = Vector_2(vx, vy);
+		const Point_2& source = m_players.pos[id];
+		Vector_2 v(vx, vy);
 
 		playerTurn.trajectory = m_stageObstacles->getPlayerTrajectory(source,
 			v, getPlayerSize(id));
-	}
-
-	return std::make_shared<CoreActionNone>();
+	});
 }
 
-CoreActionPtr Core::findPlayerAndBonusCollisions(
+void Core::findPlayerAndBonusCollisions(
 	TurnData& turnData)
 {
-	CoreActionMultiple::ActionsCollection actionsGroup;
-	CoreActionPtr actionFindPlayerPlayerCollisions,
-		actionFindPlayerBonusCollisions;
-
-	for (auto& [id, playerTurn] : turnData.playerTurns) {
-		actionFindPlayerPlayerCollisions = findPlayerPlayerCollisions(id,
-			playerTurn, turnData);
-		actionFindPlayerBonusCollisions = findPlayerBonusCollisions(id,
-			playerTurn, turnData);
-		
-		// Add to actions list
-		actionsGroup.push_back(actionFindPlayerPlayerCollisions);
-		actionsGroup.push_back(actionFindPlayerBonusCollisions);
-	}
+	findPlayerPlayerCollisions(turnData);
 
-	// Merge
-	auto res = CoreActionMultiple::getMergedActions(actionsGroup);
+	forEachAlivePlayer([this, &turnData](PlayerId id) {
+		findPlayerBonusCollisions(id, turnData.playerTurns[id]);
+	});
 
-	return res;
+	// Merged serially, in the order of the players
+	for (PlayerId id : m_players.alive) {
+		for (const auto& collision : turnData.playerTurns[id].bonusCollisions) {
+			turnData.collectedBonuses.push_back(collision.id);
+		}
+	}
+	// A bonus may be collected by more players at once
+	auto& collected = turnData.collectedBonuses;
+	std::sort(collected.begin(), collected.end());
+	collected.erase(std::unique(collected.begin(), collected.end()),
+		collected.end());
 }
 
-CoreActionPtr Core::updatePlayersStates(TurnData& turnData)
+void Core::updatePlayersStates(TurnData& turnData)
 {
-	CoreActionMultiple::ActionsCollection actionsGroup;
-	CoreActionPtr actionMovePlayer, actionChangePlayerHp,
-		actionApplyPlayerBonusCollisions;
-	
-	for (auto& [id, playerTurn] : turnData.playerTurns) {
-		actionMovePlayer = movePlayer(id, playerTurn, turnData);
-		actionChangePlayerHp = changePlayerHp(id, playerTurn, turnData);
-		actionApplyPlayerBonusCollisions = applyPlayerBonusCollisions(id,
-			playerTurn, turnData);
-		
-		// Add to actions list
-		actionsGroup.push_back(actionMovePlayer);
-		actionsGroup.push_back(actionChangePlayerHp);
-		actionsGroup.push_back(actionApplyPlayerBonusCollisions);
-	}
+	for (PlayerId id : m_players.alive) {
+		auto& playerTurn = turnData.playerTurns[id];
 
-	// Merge
-	auto res = CoreActionMultiple::getMergedActions(actionsGroup);
+		movePlayer(id, playerTurn, turnData);
+		changePlayerHp(id, playerTurn, turnData);
+		applyPlayerBonusCollisions(id, playerTurn, turnData);
+	}
 
-	return res;
+	// Remove the players killed in this turn
+	compactAlivePlayers();
 }
 
-CoreActionPtr Core::checkIsGameOver(TurnData& turnData)
+void Core::checkIsGameOver(TurnData& turnData)
 {
 	(void)turnData;
 
-	if (m_players.size() == 0) {
+	if (m_players.alive.size() == 0) {
 		// Draw game
 
-		auto res = std::make_shared<CoreActionAnnounceDrawGame>();
-		return res;
+		m_isOver = true;
+
+		m_events.pushAnnounceDrawGame();
 	}
-	else if (m_players.size() == 1) {
+	else if (m_players.alive.size() == 1) {
 		// Winner
 
-		auto iter = m_players.cbegin();
-		PlayerId id = iter->first;
+		m_isOver = true;
 
-		auto res = std::make_shared<CoreActionAnnounceWinner>(id);
-		return res;
-	}
-	else {
-		return std::make_shared<CoreActionNone>();
+		m_events.pushAnnounceWinner(m_players.alive.front());
 	}
 }
 
-CoreActionPtr Core::clearBonuses(TurnData& turnData)
+void Core::clearBonuses(TurnData& turnData)
 {
-	std::vector<CoreActionPtr> actionsGroup;
-	std::shared_ptr<CoreActionRemoveBonus> actionRemoveBonus;
-
 	for (BonusId id : turnData.collectedBonuses) {
 		double hpRecovery = m_stageBonuses->getBonusHpRecovery(id);
 
 		// Clear
 		m_stageBonuses->clearBonus(id);
 
-		// Reset timer
-		resetBonusTimer();
+		// Reset countdown
+		resetBonusCountdown();
 
-		// Add to actions list
-		actionRemoveBonus = std::make_shared<CoreActionRemoveBonus>(id,
-			hpRecovery);
-		actionsGroup.push_back(std::move(actionRemoveBonus));
+		m_events.pushRemoveBonus(id, hpRecovery, true);
 	}
-
-	// Merge
-	auto res = CoreActionMultiple::getMergedActions(actionsGroup);
-
-	return res;
 }
 
-CoreActionPtr Core::generateBonus(TurnData& turnData)
+void Core::generateBonus(TurnData& turnData)
 {
 	(void)turnData;
 
+	if (m_bonusCountdown > 0) {
+		m_bonusCountdown--;
+	}
+
 	if (m_stageBonuses->canGenerateBonus()) {
-		if (m_bonusTimer.isLap()) {
+		if (m_bonusCountdown == 0) {
 #ifdef ENABLE_BONUS_CONSTRAINTS
 			auto playerStatesMap = getPlayerStates();
 			std::vector<PlayerState> playerStatesVec;
@@ -218,54 +252,112 @@ CoreActionPtr Core::generateBonus(TurnData& turnData)
 			m_stageBonuses->reportPlayerStates(playerStatesVec);
 #endif // ENABLE_BONUS_CONSTRAINTS
 
-			BonusId bonusId = m_stageBonuses->generateBonus();
+			BonusId bonusId = m_stageBonuses->generateBonus(m_rng);
 			if (bonusId == BONUS_ID_NULL) {
-				// Bonus could not be generated
-				
-				return std::make_shared<CoreActionNone>();
+				// Bonus could not be generated -- try again later
+
+				resetBonusCountdown();
 			} else {
 				const PointF& bonusPos = m_stageBonuses->getBonuses().at(bonusId).position;
 
-				auto res = std::make_shared<CoreActionAddBonus>(bonusId, bonusPos);
-				return res;
+				m_events.pushAddBonus(bonusId, bonusPos);
 			}
 		}
 	}
-	
-	// Else
-	return std::make_shared<CoreActionNone>();
 }
 
-CoreActionPtr Core::findPlayerPlayerCollisions(PlayerId id,
-	PlayerTurn& playerTurn, TurnData& turnData)
+void Core::findPlayerPlayerCollisions(TurnData& turnData)
 {
-	// Aliases
-	PlayerId& idA = id;
-	PlayerTurn& playerTurnA = playerTurn;
-
-	for (const auto& [idB, playerTurnB] : turnData.playerTurns) {
-		if (idA == idB) continue; // A player cannot collide with itself
-
-		// Minimum distance between players' trajectories
-		double minSqdist = playerTurnA.trajectory.minSqdist(
-			playerTurnB.trajectory);
-		// Square of sum of the players' sizes
-		double playerSqsizes = sqr(getPlayerSize(idA) + getPlayerSize(idB));
-
-		if (minSqdist <= playerSqsizes) {
-			// Add collision with B to A's player collisions
-			PlayerCollision collision = {
-				getPlayerStrength(idB) // opponentStrength
-			};
-			playerTurnA.playerCollisions.push_back(collision);
-		}
+	// Alias
+	auto& entries = m_playerSweepEntries;
+
+	// Broadphase entries
+	entries.clear();
+	for (PlayerId id : m_players.alive) {
+		auto& playerTurn = turnData.playerTurns[id];
+		double size = m_players.size[id];
+		CGAL::Bbox_2 trajBbox = playerTurn.trajectory.bbox();
+
+		entries.push_back(PlayerSweepEntry{
+			CGAL::Bbox_2(
+				trajBbox.xmin() - size,
+				trajBbox.ymin() - size,
+				trajBbox.xmax() + size,
+				trajBbox.ymax() + size
+			), // bbox
+			id, // id
+			&playerTurn, // turn
+			size, // size
+			m_players.strength[id], // strength
+		});
 	}
 
-	return std::make_shared<CoreActionNone>();
+	// Sort by the left edge (ties by ID, so the order is deterministic)
+	std::sort(entries.begin(), entries.end(),
+		[](const PlayerSweepEntry& lhs, const PlayerSweepEntry& rhs) {
+			if (lhs.bbox.xmin() != rhs.bbox.xmin()) {
+				return lhs.bbox.xmin() < rhs.bbox.xmin();
+			}
+			return lhs.id < rhs.id;
+		}
+	);
+
+	// Sweep (each chunk of the entries records its pairs separately)
+	m_sweepPairChunks.resize(getChunkCount(entries.size()));
+	parallelFor(entries.size(), [this](size_t chunk, size_t begin, size_t end) {
+		const auto& entries = m_playerSweepEntries;
+		auto& pairs = m_sweepPairChunks[chunk];
+		pairs.clear();
+
+		for (size_t i = begin; i < end; i++) {
+			const auto& entryA = entries[i];
+
+			for (size_t j = i + 1; j < entries.size(); j++) {
+				const auto& entryB = entries[j];
+
+				// The rest of the entries start right of A
+				if (entryB.bbox.xmin() > entryA.bbox.xmax()) break;
+
+				// Y overlap
+				if (entryB.bbox.ymin() > entryA.bbox.ymax()
+					|| entryA.bbox.ymin() > entryB.bbox.ymax())
+				{
+					continue;
+				}
+
+				// Minimum distance between players' trajectories
+				double minSqdist = entryA.turn->trajectory.minSqdist(
+					entryB.turn->trajectory);
+				// Square of sum of the players' sizes
+				double playerSqsizes = sqr(entryA.size + entryB.size);
+
+				if (minSqdist <= playerSqsizes) {
+					pairs.emplace_back(i, j);
+				}
+			}
+		}
+	});
+
+	// Add collision to both players (the chunks are in the order of `i`, so
+	// the collisions are added in the same order as by a serial sweep)
+	for (const auto& pairs : m_sweepPairChunks) {
+		for (const auto& [i, j] : pairs) {
+			const auto& entryA = entries[i];
+			const auto& entryB = entries[j];
+
+			entryA.turn->playerCollisions.push_back(PlayerCollision{
+				entryB.id, // opponentId
+				entryB.strength, // opponentStrength
+			});
+			entryB.turn->playerCollisions.push_back(PlayerCollision{
+				entryA.id, // opponentId
+				entryA.strength, // opponentStrength
+			});
+		}
+	}
 }
 
-CoreActionPtr Core::findPlayerBonusCollisions(PlayerId id,
-	PlayerTurn& playerTurn, TurnData& turnData)
+void Core::findPlayerBonusCollisions(PlayerId id, PlayerTurn& playerTurn)
 {
 	// Alias
 	PlayerId& playerId = id;
@@ -284,145 +376,183 @@ CoreActionPtr Core::findPlayerBonusCollisions(PlayerId id,
 			// Add the collision to the player's bonus collisions
 			BonusCollision collision = {bonusId};
 			playerTurn.bonusCollisions.push_back(std::move(collision));
-
-			// Add the collision to turn data
-			turnData.collectedBonuses.insert(bonusId);
 		}
 	}
-
-	return std::make_shared<CoreActionNone>();
 }
 
-CoreActionPtr Core::movePlayer(PlayerId id,
+void Core::movePlayer(PlayerId id,
 	PlayerTurn& playerTurn, TurnData& turnData)
 {
 	(void)turnData;
 
 	// Alias
-	auto& player = *playerTurn.playerRef;
+	auto& pos = m_players.pos[id];
 
 	// Move player
 #ifndef OLD_TRAJECTORY_ALGORITHM
-	player.pos = playerTurn.trajectory.end();
+	pos = playerTurn.trajectory.end();
 #else
-	player.pos = playerTurn.trajectory.last().getPEnd();
+	pos = playerTurn.trajectory.last().getPEnd();
 #endif
-
-	// Create action
-	auto res = std::make_shared<CoreActionSetPlayerPos>(id,
-		fromCgalPoint(player.pos));
-	
-	return res;
 }
 
-CoreActionPtr Core::changePlayerHp(PlayerId id,
+void Core::changePlayerHp(PlayerId id,
 	PlayerTurn& playerTurn, TurnData& turnData)
 {
-	(void)turnData;
+	// Aliases
+	auto& hp = m_players.hp[id];
+	auto& collisions = playerTurn.playerCollisions;
 
-	// Alias
-	auto& player = *playerTurn.playerRef;
+	// The sweep finds the collisions in the order of the bounding boxes
+	std::sort(collisions.begin(), collisions.end(),
+		[](const PlayerCollision& lhs, const PlayerCollision& rhs) {
+			return lhs.opponentId < rhs.opponentId;
+		}
+	);
+
+	hp = getNewPlayerHp(*m_stageObstacles, m_players.pos[id], hp, collisions,
+		turnData.effectAttributes[id].getAttributeChangeHp(),
+		m_players.inputFlags[id].deflate);
+
+	if (hp <= 0.0) {
+		// Player is dead
 
+		// "Kill"
+		killPlayer(id);
+
+		m_events.pushRemovePlayer(id);
+	} else {
+		// Player is still alive
+
+		updatePlayerAttributes(id);
+
+		reportPlayerState(id, false);
+	}
+}
+
+double Core::getNewPlayerHp(const StageObstacles& obstacles,
+	const Point_2& pos, double hp,
+	const std::vector<PlayerCollision>& collisions, double effectHpChange,
+	bool isDeflating)
+{
 	double hpDelta = 0.0;
 
 	// Decrement HP from player collisions
-	for (const auto& collision : playerTurn.playerCollisions) {
+	for (const auto& collision : collisions) {
 		hpDelta -= TICK_INTERVAL * collision.opponentStrength;
 	}
 
 	// Increment HP from bonus effects
-	hpDelta += playerTurn.effectAttributes.getAttributeChangeHp();
+	hpDelta += effectHpChange;
 
 	// Decrement HP from "deflate"
-	if (player.input->readInput().deflate) {
+	if (isDeflating) {
 		double newDelta = hpDelta - DEFLATE_AMOUNT;
-		if (!(player.hp + newDelta <= 0.0)) {
+		if (!(hp + newDelta <= 0.0)) {
 			// Can deflate, because it won't kill the player
 			hpDelta = newDelta;
 		}
 	}
 
 	// Don't grow if that would make you collide with an obstacle
-	if ((hpDelta > 0.0) && m_stageObstacles->playerHasCollision(player.pos,
-		getPlayerSize(player.hp + hpDelta)))
+	if ((hpDelta > 0.0) && obstacles.playerHasCollision(pos,
+		getPlayerSize(hp + hpDelta)))
 	{
 		hpDelta = 0.0;
 	}
 
-	player.hp += hpDelta;
-
-	if (player.hp <= 0.0) {
-		// Player is dead
-
-		// "Kill"
-		m_players.erase(id);
-		m_gsAgentProxy->killPlayer(id);
-
-		// Create action
-		auto res = std::make_shared<CoreActionRemovePlayer>(id);
-
-		return res;
-	} else {
-		// Player is still alive
-
-		// Create actions
-		auto actionSetPlayerHp = std::make_shared<CoreActionSetPlayerHp>(id,
-			player.hp);
-		auto actionSetPlayerSize = std::make_shared<CoreActionSetPlayerSize>(id,
-			getPlayerSize(player.hp));
-
-		// Merge
-		auto res = CoreActionMultiple::getMergedActions(actionSetPlayerHp,
-			actionSetPlayerSize);
-		
-		return res;
-	}
+	return hp + hpDelta;
 }
 
-CoreActionPtr Core::applyPlayerBonusCollisions(PlayerId id,
+void Core::applyPlayerBonusCollisions(PlayerId id,
 	PlayerTurn& playerTurn, TurnData& turnData)
 {
-	(void)id;
 	(void)turnData;
 
-	// Alias
-	auto& player = *playerTurn.playerRef;
+	if (!m_players.isAlive[id]) {
+		// Killed in this turn; the bonus is collected, but has no effect
+		return;
+	}
 
 	for (const auto& coll : playerTurn.bonusCollisions) {
-		auto effect = m_stageBonuses->getBonusEffect(coll.id);
-		player.bonusEffects.insert(effect);
+		m_stageBonuses->addBonusEffect(coll.id, id, m_bonusEffects);
 	}
-
-	return std::make_shared<CoreActionNone>();
 }
 
-Timer Core::createNewBonusTimer()
+size_t Core::createNewBonusCountdown()
 {
 	static constexpr double PARAM_ALPHA = 10.95;
 	static constexpr double PARAM_BETA = 0.95;
-	static std::gamma_distribution distrib(PARAM_ALPHA, PARAM_BETA);
+	std::gamma_distribution distrib(PARAM_ALPHA, PARAM_BETA);
 	
-	double interval = distrib(getRNGine());
-	return Timer(static_cast<std::clock_t>(interval * 1000.0));
+	// Seconds -> ticks
+	double interval = distrib(m_rng);
+	return static_cast<size_t>(interval * 1000.0 / TICK_INTERVAL);
 }
 
-void Core::resetBonusTimer()
+void Core::resetBonusCountdown()
 {
-	m_bonusTimer = createNewBonusTimer();
+	m_bonusCountdown = createNewBonusCountdown();
 }
 
 void Core::notifyAgents()
 {
 	m_gsAgentProxy->update();
 
-	for (auto& agent : m_aiAgents) {
-		agent->plan();
+	for (size_t i = 0; i < m_aiAgents.size(); i++) {
+		// If not, it is degraded -- keeps the input of the last plan
+		m_isAgentPlanning[i] = m_watchdog.shouldPlan(i);
+	}
+
+	if (!isAgentPlanningParallel()) {
+		planAgents(0, m_aiAgents.size());
+	}
+}
+
+bool Core::isAgentPlanningParallel() const
+{
+#if defined(OLD_TRAJECTORY_ALGORITHM) || defined(INCLUDE_BENCHMARK)
+	// Neither the exact kernel nor the benchmark is thread-safe
+	return false;
+#else
+	return (m_workerPool != nullptr);
+#endif
+}
+
+void Core::planAgents(size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; i++) {
+		if (!m_isAgentPlanning[i]) {
+			m_agentPlanDurations[i] = 0.0;
+			continue;
+		}
+
+		auto tStart = TickWatchdog::Clock::now();
+		m_aiAgents[i]->plan();
+		m_agentPlanDurations[i] = std::chrono::duration<double, std::milli>(
+			TickWatchdog::Clock::now() - tStart).count();
+	}
+}
+
+void Core::startAgentPlanning()
+{
+	if (!isAgentPlanningParallel()) return;
+
+	// One agent per chunk -- the planning times differ a lot
+	m_workerPool->start(m_aiAgents.size(), m_aiAgents.size(),
+		m_planAgentsJob);
+}
+
+void Core::joinAgents()
+{
+	if (m_workerPool != nullptr) {
+		m_workerPool->wait();
 	}
 }
 
 double Core::getPlayerSize(PlayerId id) const
 {
-	return getPlayerSize(m_players.at(id).hp);
+	return m_players.size[id];
 }
 
 double Core::getPlayerSize(double hp)
@@ -442,7 +572,7 @@ double Core::getPlayerSize(double hp)
 
 double Core::getPlayerSpeed(PlayerId id) const
 {
-	return getPlayerSpeed(m_players.at(id).hp);
+	return m_players.speed[id];
 }
 
 double Core::getPlayerSpeed(double hp)
@@ -459,7 +589,7 @@ double Core::getPlayerSpeed(double hp)
 
 double Core::getPlayerStrength(PlayerId id) const
 {
-	return getPlayerStrength(m_players.at(id).hp);
+	return m_players.strength[id];
 }
 
 double Core::getPlayerStrength(double hp)
@@ -480,8 +610,7 @@ double Core::getPlayerStrength(double hp)
 
 void Core::getPlayerMovementVector(PlayerId id, double& x, double& y) const
 {
-	const auto& player = m_players.at(id);
-	return getPlayerMovementVector(player.input->readInput(),
+	return getPlayerMovementVector(m_players.inputFlags[id],
 		getPlayerSpeed(id), x, y);
 }
 
@@ -493,196 +622,497 @@ void Core::getPlayerMovementVector(const PlayerInputFlags& inputFlags,
 	y *= speed * TICK_INTERVAL;
 }
 
-CoreActionPtr Core::initializeStage()
+void Core::initializeStage()
 {
-	// Initialize all
-	auto actionInitPlayers = initializeStagePlayers();
-	auto actionInitObstaclesAndBounds = initializeStageObstaclesAndBounds();
-	auto actionInitBonuses = initializeStageBonuses();
-	auto actionInitAiAgents = initializeStageAiAgents();
+	// Initialize all (the obstacles first, the players are spawned in the
+	// free space)
+	initializeStageObstaclesAndBounds();
+	initializeStagePlayers();
+	initializeStageBonuses();
+	initializeStageAiAgents();
+
+	if (!m_gsdata.recordPath.empty()) {
+		initializeInputRecorder();
+	}
 
 	m_isInitialized = true;
-	
-	// Merge
-	auto res = CoreActionMultiple::getMergedActions(
-		actionInitPlayers,
-		actionInitObstaclesAndBounds,
-		actionInitBonuses,
-		actionInitAiAgents
-	);
-	
-	return res;
 }
 
-CoreActionPtr Core::initializeStagePlayers()
+void Core::initializeInputRecorder()
 {
-	PlayerStateInternal newPlayer;
+	try {
+		m_inputRecorder = std::make_unique<ReplayWriter>(m_gsdata.recordPath,
+			m_gsdata.stageId, m_gsdata.seed, m_gsdata.players.size());
 
-	CoreActionMultiple::ActionsCollection actionGroup;
-	std::shared_ptr<CoreActionAddPlayer> actionAddPlayer;
-	std::shared_ptr<CoreActionSetPlayerPos> actionSetPlayerPos;
-	std::shared_ptr<CoreActionSetPlayerHp> actionSetPlayerHp;
-	std::shared_ptr<CoreActionSetPlayerSize> actionSetPlayerSize;
+	} catch (const Replay::Exception& e) {
+		if (!m_gsdata.isRecordingOptional) {
+			throw;
+		}
+		std::cerr << "The match is not recorded: " << e.what() << std::endl;
+	}
+}
+
+void Core::initializeStagePlayers()
+{
+	const size_t playerCount = m_gsdata.players.size();
+
+	m_players.pos.resize(playerCount);
+	m_players.hp.resize(playerCount);
+	m_players.size.resize(playerCount);
+	m_players.speed.resize(playerCount);
+	m_players.strength.resize(playerCount);
+	m_players.input.resize(playerCount);
+	m_players.inputFlags.resize(playerCount);
+	m_players.isAlive.resize(playerCount);
+	m_players.alive.reserve(playerCount);
+	m_players.reportedPos.resize(playerCount);
+	m_players.reportedHp.resize(playerCount);
+	m_players.reportedSize.resize(playerCount);
+
+	initializePlayerPositions();
 	
-	for (PlayerId id = 0; id < m_gsdata.players.size(); id++) {
+	for (PlayerId id = 0; id < playerCount; id++) {
 		// Initialize player
-		const auto& playerPos = m_gsdata.stage->getPlayers()[id];
-		newPlayer.pos = Point_2(playerPos.x, playerPos.y);
-		newPlayer.hp = PLAYER_HP_INITIAL;
-		newPlayer.input = m_gsdata.players[id];
-		m_players[id] = std::move(newPlayer);
-
-		// Add to actions list
-		actionAddPlayer = std::make_shared<CoreActionAddPlayer>(id);
-		actionSetPlayerPos = std::make_shared<CoreActionSetPlayerPos>(id,
-			fromCgalPoint(newPlayer.pos));
-		actionSetPlayerHp = std::make_shared<CoreActionSetPlayerHp>(id,
-			newPlayer.hp);
-		actionSetPlayerSize = std::make_shared<CoreActionSetPlayerSize>(id,
-			getPlayerSize(newPlayer.hp));
-		actionGroup.push_back(actionAddPlayer);
-		actionGroup.push_back(actionSetPlayerPos);
-		actionGroup.push_back(actionSetPlayerHp);
-		actionGroup.push_back(actionSetPlayerSize);
-	}
-
-	// Merge
-	auto res = CoreActionMultiple::getMergedActions(actionGroup);
+		m_players.hp[id] = PLAYER_HP_INITIAL;
+		m_players.input[id] = m_gsdata.players[id];
+		m_players.isAlive[id] = true;
+		m_players.alive.push_back(id);
+		updatePlayerAttributes(id);
+
+		m_events.pushAddPlayer(id);
+		reportPlayerState(id, true);
+	}
+}
 
-	return res;
+void Core::reportPlayerState(PlayerId id, bool force)
+{
+	const auto& steps = m_gsdata.playerEventSteps;
+	PointF pos = fromCgalPoint(m_players.pos[id]);
+	double hp = m_players.hp[id];
+	double size = m_players.size[id];
+
+	auto& reportedPos = m_players.reportedPos[id];
+	if (force
+		|| isChangeReported(reportedPos.x, pos.x, steps.pos)
+		|| isChangeReported(reportedPos.y, pos.y, steps.pos))
+	{
+		reportedPos = pos;
+		m_events.pushSetPlayerPos(id, pos);
+	}
+
+	auto& reportedHp = m_players.reportedHp[id];
+	if (force || isChangeReported(reportedHp, hp, steps.hp)) {
+		reportedHp = hp;
+		m_events.pushSetPlayerHp(id, hp);
+	}
+
+	auto& reportedSize = m_players.reportedSize[id];
+	if (force || isChangeReported(reportedSize, size, steps.size)) {
+		reportedSize = size;
+		m_events.pushSetPlayerSize(id, size);
+	}
+}
+
+bool Core::isChangeReported(double reported, double value, double step)
+{
+	if (step <= 0.0) {
+		return value != reported;
+	}
+
+	// Compare the multiples of the step, so the receiver sees the same
+	// rounded value as if every change was reported
+	return std::floor(value / step) != std::floor(reported / step);
+}
+
+void Core::updatePlayerAttributes(PlayerId id)
+{
+	double hp = m_players.hp[id];
+
+	m_players.size[id] = getPlayerSize(hp);
+	m_players.speed[id] = getPlayerSpeed(hp);
+	m_players.strength[id] = getPlayerStrength(hp);
+}
+
+void Core::killPlayer(PlayerId id)
+{
+	m_players.isAlive[id] = false;
+	m_bonusEffects.removePlayer(id);
+	m_gsAgentProxy->killPlayer(id);
+}
+
+void Core::compactAlivePlayers()
+{
+	auto& alive = m_players.alive;
+	alive.erase(
+		std::remove_if(alive.begin(), alive.end(),
+			[this](PlayerId id) { return !m_players.isAlive[id]; }),
+		alive.end()
+	);
+}
+
+void Core::initializePlayerPositions()
+{
+	const auto& stagePlayers = m_gsdata.stage->getPlayers();
+	const size_t playerCount = m_players.pos.size();
+	const size_t stagePlayerCount = std::min(playerCount, stagePlayers.size());
+
+	for (PlayerId id = 0; id < stagePlayerCount; id++) {
+		m_players.pos[id] = toCgalPoint(stagePlayers[id]);
+	}
+
+	if (playerCount == stagePlayerCount) return;
+
+	// The rest is spawned in the free space. The spawn points have their own
+	// RNG, so the simulation RNG does not depend on the number of players.
+	auto seedWords = splitSeed(m_gsdata.seed);
+	std::seed_seq seedSeq{seedWords[0], seedWords[1], SPAWN_SEED_TAG};
+	uint32_t spawnSeed;
+	seedSeq.generate(&spawnSeed, &spawnSeed + 1);
+	RNGineType spawnRng(spawnSeed);
+
+	SpawnGenerator spawnGenerator(m_stageObstacles->getDistanceField(),
+		getStageSize(), getPlayerSize(PLAYER_HP_INITIAL), spawnRng);
+	for (PlayerId id = 0; id < stagePlayerCount; id++) {
+		spawnGenerator.reserve(m_players.pos[id]);
+	}
+	for (PlayerId id = stagePlayerCount; id < playerCount; id++) {
+		m_players.pos[id] = spawnGenerator.generate();
+	}
 }
 
-CoreActionPtr Core::initializeStageObstaclesAndBounds()
+void Core::initializeStageObstaclesAndBounds()
 {
 	auto obstacles = getObstaclesList();
 	auto bounds = getStageSize();
 
-	CoreActionMultiple::ActionsCollection actionsGroup;
-	std::shared_ptr<CoreActionAddObstacle> actionAddObstacle;
-	std::shared_ptr<CoreActionSetStageSize> actionSetStageSize;
-
-	m_stageObstacles = std::make_unique<StageObstacles>(obstacles, bounds);
+	if (m_stageObstacles == nullptr) {
+		m_stageObstacles = std::make_shared<StageObstacles>(obstacles, bounds);
+	}
 
-	// Actions
+	// Events
 	// Obstacles
 	for (const auto& obstacle : obstacles) {
-		actionAddObstacle = std::make_shared<CoreActionAddObstacle>(
-			PolygonF(obstacle));
-		actionsGroup.push_back(actionAddObstacle);
+		m_events.pushAddObstacle(PolygonF(obstacle));
 	}
 	// Bounds
-	actionSetStageSize = std::make_shared<CoreActionSetStageSize>(bounds);
-	actionsGroup.push_back(actionSetStageSize);
+	m_events.pushSetStageSize(bounds);
+}
 
-	// Merge
-	auto res = CoreActionMultiple::getMergedActions(actionsGroup);
+void Core::initializeStageBonuses()
+{
+	if (m_stageBonuses == nullptr) {
+		m_stageBonuses = std::make_unique<StageBonuses>(getObstaclesList(),
+			m_stageObstacles->getDistanceField(), getStageSize(), m_rng);
+	}
+}
 
-	return res;
+size_t Core::getChunkCount(size_t count) const
+{
+#ifdef OLD_TRAJECTORY_ALGORITHM
+	// The exact kernel is not thread-safe
+	return 1;
+#else
+	if (m_workerPool == nullptr || count < PARALLEL_MIN_PLAYERS) {
+		return 1;
+	}
+
+	size_t threadCount = m_workerPool->getWorkerCount() + 1;
+	return std::min(count, threadCount * PARALLEL_CHUNKS_PER_THREAD);
+#endif // OLD_TRAJECTORY_ALGORITHM
 }
 
-CoreActionPtr Core::initializeStageBonuses()
+void Core::parallelFor(size_t count, const WorkerPool::ChunkFunction& fn)
 {
-	m_stageBonuses = std::make_unique<StageBonuses>(
-		getObstaclesList(), getStageSize());
-	
-	return std::make_shared<CoreActionNone>();
+	size_t chunkCount = getChunkCount(count);
+
+	if (chunkCount == 1) {
+		fn(0, 0, count);
+	} else {
+		m_workerPool->run(count, chunkCount, fn);
+	}
 }
 
-CoreActionPtr Core::initializeStageAiAgents()
+void Core::forEachAlivePlayer(const std::function<void(PlayerId)>& fn)
+{
+	const auto& alive = m_players.alive;
+
+	parallelFor(alive.size(), [&alive, &fn](size_t chunk, size_t begin,
+		size_t end)
+	{
+		(void)chunk;
+
+		for (size_t i = begin; i < end; i++) {
+			fn(alive[i]);
+		}
+	});
+}
+
+void Core::initializeStageAiAgents()
 {
 	// Copy
 	m_aiAgents = m_gsdata.aiAgents;
 
+	if (m_stageGridModel == nullptr) {
+		m_stageGridModel = std::make_shared<StageGridModel>(
+			getObstaclesList(), getStageSize(), m_workerPool.get());
+	}
+
 	// Create a game state proxy
-	m_gsAgentProxy = std::make_shared<GameStateAgentProxyImplem>(*this);
+	m_gsAgentProxy = std::make_shared<GameStateAgentProxyImplem>(*this,
+		m_stageGridModel);
+
+	// The agents get their own seeds, so the simulation RNG does not depend
+	// on the number of agents (a replay has none)
+	auto seedWords = splitSeed(m_gsdata.seed);
+	std::seed_seq seedSeq(seedWords.begin(), seedWords.end());
+	std::vector<uint32_t> agentSeeds(m_aiAgents.size());
+	seedSeq.generate(agentSeeds.begin(), agentSeeds.end());
 
 	// Assign it to the agents
-	for (auto& agent : m_aiAgents) {
-		agent->assignProxy(m_gsAgentProxy);
+	for (size_t i = 0; i < m_aiAgents.size(); i++) {
+		m_aiAgents[i]->assignProxy(m_gsAgentProxy);
+		m_aiAgents[i]->seedRNG(agentSeeds[i]);
+		m_aiAgents[i]->setPlanBudget(m_gsdata.agentPlanBudget);
 	}
-	
-	return std::make_shared<CoreActionNone>();
+
+	m_watchdog.setAgentCount(m_aiAgents.size());
+	m_isAgentPlanning.assign(m_aiAgents.size(), false);
+	m_agentPlanDurations.assign(m_aiAgents.size(), 0.0);
 }
 
-CoreActionPtr Core::tick()
+void Core::tick()
 {
+	m_watchdog.startTick();
+	m_profiler.startTick();
+	joinAgents();
+	m_profiler.lap(TickProfiler::PHASE_JOIN_AGENTS);
+
+	m_tickCount++;
+
 #ifdef INCLUDE_BENCHMARK
 	Benchmark::get().beginMeasure(BENCH_ID_PL_ACTIONS);
 #endif // INCLUDE_BENCHMARK
-	auto res = playersActions();
+	playersActions();
 #ifdef INCLUDE_BENCHMARK
 	Benchmark::get().endMeasure(BENCH_ID_PL_ACTIONS);
 #endif // INCLUDE_BENCHMARK
 	notifyAgents();
-	return res;
+	m_profiler.lap(TickProfiler::PHASE_NOTIFY_AGENTS);
+	m_profiler.endTick();
+	m_watchdog.endTick(m_tickCount, m_profiler, m_agentPlanDurations);
+
+	// The planning overlaps with whatever happens until the next tick
+	startAgentPlanning();
 }
 
-CoreActionPtr Core::playersActions()
-{
-	TurnData turnData;
-
-	auto actionInitTurnData = initTurnData(turnData);
-	auto actionApplyPlayerEffects = applyPlayerEffects(turnData);
-	auto actionCalculateTrajectories = calculateTrajectories(turnData);
-	auto actionFindPlayerAndBonusCollisions =
-		findPlayerAndBonusCollisions(turnData);
-	auto actionUpdatePlayersStates = updatePlayersStates(turnData);
-	auto actionCheckIsGameOver = checkIsGameOver(turnData);
-	auto actionClearBonuses = clearBonuses(turnData);
-	auto actionGenerateBonus = generateBonus(turnData);
-
-	auto res = CoreActionMultiple::getMergedActions(
-		actionInitTurnData,
-		actionApplyPlayerEffects,
-		actionCalculateTrajectories,
-		actionFindPlayerAndBonusCollisions,
-		actionUpdatePlayersStates,
-		actionCheckIsGameOver,
-		actionClearBonuses,
-		actionGenerateBonus
-	);
-	return res;
+void Core::playersActions()
+{
+	// Alias
+	TurnData& turnData = m_turnData;
+
+	readPlayerInputs(turnData);
+	m_profiler.lap(TickProfiler::PHASE_READ_INPUTS);
+	initTurnData(turnData);
+	m_profiler.lap(TickProfiler::PHASE_INIT_TURN_DATA);
+	applyPlayerEffects(turnData);
+	m_profiler.lap(TickProfiler::PHASE_APPLY_PLAYER_EFFECTS);
+	calculateTrajectories(turnData);
+	m_profiler.lap(TickProfiler::PHASE_CALCULATE_TRAJECTORIES);
+	findPlayerAndBonusCollisions(turnData);
+	m_profiler.lap(TickProfiler::PHASE_FIND_COLLISIONS);
+	updatePlayersStates(turnData);
+	m_profiler.lap(TickProfiler::PHASE_UPDATE_PLAYERS_STATES);
+	checkIsGameOver(turnData);
+	m_profiler.lap(TickProfiler::PHASE_CHECK_IS_GAME_OVER);
+	clearBonuses(turnData);
+	m_profiler.lap(TickProfiler::PHASE_CLEAR_BONUSES);
+	generateBonus(turnData);
+	m_profiler.lap(TickProfiler::PHASE_GENERATE_BONUS);
 }
 
 void Core::quit()
 {
+	joinAgents();
+
 	for (auto& agent : m_aiAgents) {
 		agent->kill();
 	}
 }
 
-const CoreActionPtr Core::loopEvent()
+const CoreEventBuffer& Core::loopEvent()
 {
+	m_events.clear();
+
 	if (!m_isInitialized) {
 		// This should happen only once -- `initializeStage()` changes the flag
 
-		return initializeStage();
+		initializeStage();
+
+		// Don't count the initialization time as a lag
+		m_tickScheduler.reset();
 	} else {
 		// Is initialized
 
-		if (m_tickTimer.isLap()) {
-			// Tick
+		m_tickScheduler.setMaxCatchUp(m_watchdog.getMaxCatchUp());
+		unsigned tickCount = m_tickScheduler.update();
 
-			return tick();
-		} else {
-			// No tick
+		// Catch up if needed
+		for (unsigned i = 0; i < tickCount; i++) {
+			tick();
+		}
 
-			return std::make_shared<CoreActionNone>();
+		// Report only the final state of the ticks
+		if (tickCount > 1) {
+			m_events.coalesce();
 		}
 	}
 
+	return m_events;
+}
+
+const CoreEventBuffer& Core::step()
+{
+	m_events.clear();
+
+	if (!m_isInitialized) {
+		initializeStage();
+	} else {
+		tick();
+	}
+
+	return m_events;
+}
+
+bool Core::isOver() const
+{
+	return m_isOver;
+}
+
+const TickScheduler::Metrics& Core::getTickMetrics() const
+{
+	return m_tickScheduler.getMetrics();
+}
+
+TickProfiler& Core::getTickProfiler()
+{
+	return m_profiler;
+}
+
+const TickProfiler& Core::getTickProfiler() const
+{
+	return m_profiler;
+}
+
+const TickWatchdog& Core::getTickWatchdog() const
+{
+	return m_watchdog;
+}
+
+uint64_t Core::getTickCount() const
+{
+	return m_tickCount;
+}
+
+void Core::saveSnapshot(Snapshot& out) const
+{
 	assert(m_isInitialized);
+
+	out.tickCount = m_tickCount;
+	out.isOver = m_isOver;
+	out.bonusCountdown = m_bonusCountdown;
+	out.rng = m_rng;
+	out.pos = m_players.pos;
+	out.hp = m_players.hp;
+	out.isAlive = m_players.isAlive;
+	out.alive = m_players.alive;
+
+	out.bonusEffects = m_bonusEffects;
+
+	m_stageBonuses->saveState(out.bonuses);
+}
+
+const CoreEventBuffer& Core::restoreSnapshot(const Snapshot& snapshot)
+{
+	assert(m_isInitialized);
+	assert(snapshot.pos.size() == m_players.pos.size());
+
+	joinAgents();
+
+	m_events.clear();
+
+	// Players
+	for (PlayerId id = 0; id < m_players.pos.size(); id++) {
+		if (m_players.isAlive[id] && !snapshot.isAlive[id]) {
+			m_events.pushRemovePlayer(id);
+		} else if (!m_players.isAlive[id] && snapshot.isAlive[id]) {
+			m_events.pushAddPlayer(id);
+		}
+	}
+
+	m_players.pos = snapshot.pos;
+	m_players.hp = snapshot.hp;
+	m_players.isAlive = snapshot.isAlive;
+	m_players.alive = snapshot.alive;
+	m_bonusEffects = snapshot.bonusEffects;
+
+	for (PlayerId id : m_players.alive) {
+		updatePlayerAttributes(id);
+		reportPlayerState(id, true);
+	}
+
+	// Bonuses (the ones present in both states are kept)
+	auto isInSnapshot = [&snapshot](BonusId id, const PointF& pos) {
+		return std::any_of(snapshot.bonuses.bonuses.begin(),
+			snapshot.bonuses.bonuses.end(),
+			[id, &pos](const auto& bonus) {
+				return bonus.first == id && bonus.second.position == pos;
+			});
+	};
+	auto currentBonuses = m_stageBonuses->getBonuses();
+	for (const auto& [id, bonusData] : currentBonuses) {
+		if (!isInSnapshot(id, bonusData.position)) {
+			// Not a pickup
+			m_events.pushRemoveBonus(id, 0.0, false);
+		}
+	}
+	m_stageBonuses->restoreState(snapshot.bonuses);
+	for (const auto& [id, bonusData] : m_stageBonuses->getBonuses()) {
+		auto iter = currentBonuses.find(id);
+		if (iter == currentBonuses.end()
+			|| !(iter->second.position == bonusData.position))
+		{
+			m_events.pushAddBonus(id, bonusData.position);
+		}
+	}
+
+	// Replay
+	if (m_gsdata.replay != nullptr) {
+		m_gsdata.replay->seekTick(snapshot.tickCount);
+	}
+	if (m_inputRecorder != nullptr) {
+		m_inputRecorder->truncate(snapshot.tickCount);
+	}
+
+	m_tickCount = snapshot.tickCount;
+	m_isOver = snapshot.isOver;
+	m_bonusCountdown = snapshot.bonusCountdown;
+	m_rng = snapshot.rng;
+
+	m_gsAgentProxy->reset();
+
+	return m_events;
 }
 
 std::unordered_map<PlayerId,PlayerState> Core::getPlayerStates() const
 {
 	std::unordered_map<PlayerId,PlayerState> res;
-	for (const auto& [id, state] : m_players) {
+	for (PlayerId id : m_players.alive) {
+		const auto& pos = m_players.pos[id];
 		res[id] = PlayerState{
-			CGAL::to_double(state.pos.x()), // x
-			CGAL::to_double(state.pos.y()), // y
-			state.hp, // hp
-			getPlayerSize(id), // size
+			CGAL::to_double(pos.x()), // x
+			CGAL::to_double(pos.y()), // y
+			m_players.hp[id], // hp
+			m_players.size[id], // size
 		};
 	}
 	return res;
@@ -12,62 +12,127 @@
 #ifndef CORE_HPP
 #define CORE_HPP
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <unordered_map>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "types.hpp"
 #include "aiplayeragent/GameStateAgentProxy.hpp"
 #include "aiplayeragent/IAIPlayerAgent.hpp"
 #include "core/Common.hpp"
-#include "core/CoreAction.hpp"
 #include "core/bonuseffect/BonusEffect.hpp"
 #include "core/bonuseffect/EffectAttributes.hpp"
+#include "core/coreevent/CoreEvent.hpp"
 #include "core/geometry/Geometry.hpp"
 #include "core/playerstate/PlayerState.hpp"
+#include "core/spawngenerator/SpawnGenerator.hpp"
 #include "core/stagebonuses/StageBonuses.hpp"
 #include "core/stageobstacles/StageObstacles.hpp"
+#include "core/tickprofiler/TickProfiler.hpp"
+#include "core/tickscheduler/TickScheduler.hpp"
+#include "core/tickwatchdog/TickWatchdog.hpp"
+#include "core/workerpool/WorkerPool.hpp"
 #include "gamesetupdata/GameSetupData.hpp"
 #include "playerinput/IPlayerInput.hpp"
+#include "replay/ReplayWriter.hpp"
 #include "stageserializer/IStageSerializer.hpp"
 
 class Core {
-private:
-	struct PlayerStateInternal {
-		Point_2 pos;
-		double hp;
-		std::unordered_set<std::shared_ptr<BonusEffect>> bonusEffects;
-		std::shared_ptr<IPlayerInput> input;
+public:
+	/**
+	 * @brief The mutable state of the game.
+	 * 
+	 * @details The static stage data (obstacles, bonus grid) are not part of
+	 *          the snapshot. Nor are the states of the AI agents and inputs.
+	 */
+	struct Snapshot {
+		uint64_t tickCount;
+		bool isOver;
+		size_t bonusCountdown;
+		RNGineType rng;
+		// Indexed by the player ID
+		std::vector<Point_2> pos;
+		std::vector<double> hp;
+		std::vector<bool> isAlive;
+		std::vector<PlayerId> alive;
+		BonusEffectSystem bonusEffects;
+		StageBonuses::State bonuses;
 	};
-	struct PlayerCollision {
-		double opponentStrength;
+private:
+	/**
+	 * @brief The players' data in the structure of arrays layout.
+	 * 
+	 * @details The arrays are indexed by the player ID. The slots of dead
+	 *          players are kept, so the IDs are stable.
+	 */
+	struct PlayerStorage {
+		std::vector<Point_2> pos;
+		std::vector<double> hp;
+		// Derived from `hp` -- must be updated every time `hp` changes
+		std::vector<double> size;
+		std::vector<double> speed;
+		std::vector<double> strength;
+		std::vector<std::shared_ptr<IPlayerInput>> input;
+		// Read from `input` (or from the replay) once per tick
+		std::vector<PlayerInputFlags> inputFlags;
+		std::vector<bool> isAlive;
+		// IDs of the alive players in ascending order
+		std::vector<PlayerId> alive;
+		// Values last reported by the events
+		std::vector<PointF> reportedPos;
+		std::vector<double> reportedHp;
+		std::vector<double> reportedSize;
 	};
 	struct BonusCollision {
 		BonusId id;
 	};
 	struct PlayerTurn {
-		PlayerStateInternal* playerRef;
 		Trajectory trajectory;
 		std::vector<PlayerCollision> playerCollisions;
 		std::vector<BonusCollision> bonusCollisions;
-		EffectAttributes effectAttributes;
 	};
+	/**
+	 * @brief Data of the current tick.
+	 * 
+	 * @details Kept between ticks so the buffers can be reused.
+	 */
 	struct TurnData {
-		std::unordered_map<PlayerId, PlayerTurn> playerTurns;
-		std::unordered_set<BonusId> collectedBonuses;
+		// Indexed by the player ID; only the alive players' turns are valid
+		std::vector<PlayerTurn> playerTurns;
+		// Indexed by the player ID
+		std::vector<EffectAttributes> effectAttributes;
+		// IDs of the bonuses collected in this tick; sorted and without
+		// duplicates once all the collisions are found
+		std::vector<BonusId> collectedBonuses;
+	};
+	// Pair of indexes to the broadphase entries
+	typedef std::pair<size_t, size_t> SweepPair;
+	// Broadphase (sort and sweep) entry of a player
+	struct PlayerSweepEntry {
+		// Trajectory bounding box inflated by the player size
+		CGAL::Bbox_2 bbox;
+		PlayerId id;
+		PlayerTurn* turn;
+		double size;
+		double strength;
 	};
 
+	friend class ForwardModel;
 	friend class GameStateAgentProxyImplem;
 	class GameStateAgentProxyImplem : public GameStateAgentProxy {
 	private:
 		const Core& m_core;
 		PlayerStateCollection m_players;
-		StageGridModel m_stageGridModel;
+		// Shared with the branches of the core
+		std::shared_ptr<const StageGridModel> m_stageGridModel;
 	public:
-		GameStateAgentProxyImplem(const Core& core)
+		GameStateAgentProxyImplem(const Core& core,
+			std::shared_ptr<const StageGridModel> stageGridModel)
 			: m_core{core}
-			, m_stageGridModel(core.getObstaclesList(), core.getStageSize())
+			, m_stageGridModel{stageGridModel}
 		{}
 
 		/**
@@ -76,15 +141,17 @@ private:
 		 * @details Must be called every time the game state changes.
 		 */
 		void update() {
+			const auto& players = m_core.m_players;
+
 			// Update players
-			for (const auto& [id, playerState] : m_core.m_players) {
+			for (PlayerId id : players.alive) {
 				auto& playerRef = m_players[id];
 
-				playerRef.pos      = playerState.pos;
-				playerRef.hp       = playerState.hp;
-				playerRef.speed    = Core::getPlayerSpeed(playerState.hp);
-				playerRef.strength = Core::getPlayerStrength(playerState.hp);
-				playerRef.size     = Core::getPlayerSize(playerState.hp);
+				playerRef.pos      = players.pos[id];
+				playerRef.hp       = players.hp[id];
+				playerRef.speed    = players.speed[id];
+				playerRef.strength = players.strength[id];
+				playerRef.size     = players.size[id];
 			}
 		}
 
@@ -99,6 +166,16 @@ private:
 			m_players.erase(id);
 		}
 
+		/**
+		 * @brief Rebuilds the proxy from scratch.
+		 * 
+		 * @details Must be called after the game state has been restored.
+		 */
+		void reset() {
+			m_players.clear();
+			update();
+		}
+
 		const PlayerStateCollection& getPlayers() const override {
 			return m_players;
 		}
@@ -108,7 +185,11 @@ private:
 		}
 		
 		const StageGridModel& getStageGridModel() const override {
-			return m_stageGridModel;
+			return *m_stageGridModel;
+		}
+
+		ForwardModel createForwardModel() const override {
+			return ForwardModel(m_core);
 		}
 
 		void getPlayerMovementVector(const PlayerInputFlags& input,
@@ -142,142 +223,274 @@ private:
 	static constexpr double BASE_STRENGTH = 1.0/3400.0;
 	// HP decrement of a "deflate" action per game tick
 	static constexpr double DEFLATE_AMOUNT = BASE_STRENGTH * TICK_INTERVAL;
+	// Minimum number of players for which the tick phases are parallelized
+	static constexpr size_t PARALLEL_MIN_PLAYERS = 64;
+	// Number of chunks per thread a parallelized phase is split to (for load
+	// balancing)
+	static constexpr size_t PARALLEL_CHUNKS_PER_THREAD = 4;
+	// Mixed with the match seed to seed the spawn point generator
+	static constexpr uint32_t SPAWN_SEED_TAG = 0x5350574e;
 
 	// Has the `initializeStage()` method been called yet?
 	bool m_isInitialized;
 	// Is the game over?
 	bool m_isOver;
 	GameSetupData m_gsdata;
+	// Number of ticks since the start of the game
+	uint64_t m_tickCount;
+	// Source of all the randomness in the match. Seeded from `m_gsdata`.
+	RNGineType m_rng;
 
-	Timer m_tickTimer;
-	std::unordered_map<PlayerId, PlayerStateInternal> m_players;
+	TickScheduler m_tickScheduler;
+	TickProfiler m_profiler;
+	TickWatchdog m_watchdog;
+	PlayerStorage m_players;
+	// Active bonus effects of all the players
+	BonusEffectSystem m_bonusEffects;
 	std::vector<std::shared_ptr<IAIPlayerAgent>> m_aiAgents;
-	std::unique_ptr<StageObstacles> m_stageObstacles;
+	// The static stage data are shared with the branches of the core (and the
+	// obstacles with the forward models)
+	std::shared_ptr<const StageObstacles> m_stageObstacles;
+	std::shared_ptr<const StageGridModel> m_stageGridModel;
 	std::unique_ptr<StageBonuses> m_stageBonuses;
+	// Records the match if `m_gsdata.recordPath` is set
+	std::unique_ptr<ReplayWriter> m_inputRecorder;
 
 	std::shared_ptr<GameStateAgentProxyImplem> m_gsAgentProxy;
 
-	Timer m_bonusTimer;
+	TurnData m_turnData;
+	// Events recorded since the last `loopEvent()`/`step()` call; the buffer
+	// keeps its capacity between ticks
+	CoreEventBuffer m_events;
+	// Reused by `findPlayerPlayerCollisions()` to avoid allocations
+	std::vector<PlayerSweepEntry> m_playerSweepEntries;
+	// Colliding pairs found by each chunk of the sweep
+	std::vector<std::vector<SweepPair>> m_sweepPairChunks;
+	// Null if the ticks are computed serially. Also plans the agents.
+	std::unique_ptr<WorkerPool> m_workerPool;
+	// Indexed by the agent index; whether the agent plans in this tick
+	std::vector<bool> m_isAgentPlanning;
+	// Indexed by the agent index; duration of the last planning (ms). Written
+	// only by the planning.
+	std::vector<double> m_agentPlanDurations;
+	// Job of the worker pool planning the agents
+	WorkerPool::ChunkFunction m_planAgentsJob;
+
+	// Number of ticks until a new bonus may be generated
+	size_t m_bonusCountdown;
 
 	/**
 	 * @brief Initializes the internal stage state.
+	 */
+	void initializeStage();
+	/**
+	 * @brief Creates the recorder of the match inputs.
+	 * 
+	 * @details If the record file cannot be created and the recording is
+	 *          optional, the match is not recorded.
+	 */
+	void initializeInputRecorder();
+	void initializeStagePlayers();
+	/**
+	 * @brief Places the players at the stage positions; the players the stage
+	 *        has no position for are spawned in the free space.
+	 * 
+	 * @remark The obstacles must be initialized.
+	 */
+	void initializePlayerPositions();
+	void initializeStageObstaclesAndBounds();
+	void initializeStageBonuses();
+	void initializeStageAiAgents();
+	/**
+	 * @brief Returns the number of chunks a loop over `count` items is split
+	 *        to by `parallelFor()`.
+	 */
+	size_t getChunkCount(size_t count) const;
+	/**
+	 * @brief Calls `fn` for the chunks of `[0, count)`.
+	 * 
+	 * @details The chunks are processed in parallel if the worker pool is
+	 *          enabled, otherwise in order. The function must only write to
+	 *          the data of its own chunk.
+	 */
+	void parallelFor(size_t count, const WorkerPool::ChunkFunction& fn);
+	/**
+	 * @brief Calls `fn` for each alive player (see `parallelFor()`).
+	 */
+	void forEachAlivePlayer(const std::function<void(PlayerId)>& fn);
+	/**
+	 * @brief Updates the size, speed, and strength of the player based on
+	 *        their HP.
+	 */
+	void updatePlayerAttributes(PlayerId id);
+	/**
+	 * @brief Reports the changes of the player's position, HP, and size.
+	 * 
+	 * @details Only the changes greater than `m_gsdata.playerEventSteps` are
+	 *          reported.
+	 * 
+	 * @param force Report all the values, even if unchanged.
+	 */
+	void reportPlayerState(PlayerId id, bool force);
+	/**
+	 * @brief Checks whether the change of a value should be reported.
+	 * 
+	 * @param step Precision of the reported value (0 = any change).
+	 */
+	static bool isChangeReported(double reported, double value, double step);
+	/**
+	 * @brief Removes the player from the alive players.
 	 * 
-	 * @return The action performed.
+	 * @details The slot of the player is kept. The list of alive players is
+	 *          not compacted until `compactAlivePlayers()` is called.
+	 */
+	void killPlayer(PlayerId id);
+	/**
+	 * @brief Removes the killed players from the list of alive players.
 	 */
-	CoreActionPtr initializeStage();
-	CoreActionPtr initializeStagePlayers();
-	CoreActionPtr initializeStageObstaclesAndBounds();
-	CoreActionPtr initializeStageBonuses();
-	CoreActionPtr initializeStageAiAgents();
+	void compactAlivePlayers();
 	/**
 	 * @brief Game tick event.
 	 * 
 	 * @details Game tick is the moment when the game state progresses further.
 	 *          Players move, bonuses appear, effects are applied, etc.
-	 * 
-	 * @return The action performed.
 	 */
-	CoreActionPtr tick();
+	void tick();
 	/**
 	 * @brief Processes actions of players (movement, bonuses, etc).
 	 * 
 	 * @note Called every tick.
+	 */
+	void playersActions();
+	/**
+	 * @brief Reads the inputs of all alive players.
 	 * 
-	 * @return The action performed.
+	 * @details If the game is a replay, the recorded inputs are used instead.
+	 *          If the game is being recorded, the inputs are recorded.
 	 */
-	CoreActionPtr playersActions();
+	void readPlayerInputs(TurnData& turnData);
 	/**
 	 * @brief Initializes turn data structure.
-	 * 
-	 * @return The action performed.
 	 */
-	CoreActionPtr initTurnData(TurnData& turnData);
+	void initTurnData(TurnData& turnData);
 	/**
 	 * @brief Applies active bonus effects on players.
-	 * 
-	 * @return The action performed.
 	 */
-	CoreActionPtr applyPlayerEffects(TurnData& turnData);
+	void applyPlayerEffects(TurnData& turnData);
 	/**
 	 * @brief Calculates trajectories of players' movement.
-	 * 
-	 * @return The action performed.
 	 */
-	CoreActionPtr calculateTrajectories(TurnData& turnData);
+	void calculateTrajectories(TurnData& turnData);
 	/**
 	 * @brief Finds collisions of players with other players and bonuses.
-	 * 
-	 * @return The action performed.
 	 */
-	CoreActionPtr findPlayerAndBonusCollisions(TurnData& turnData);
+	void findPlayerAndBonusCollisions(TurnData& turnData);
 	/**
 	 * @brief Updates the players' position, healts, and active bonus effects.
-	 * 
-	 * @return The action performed.
 	 */
-	CoreActionPtr updatePlayersStates(TurnData& turnData);
+	void updatePlayersStates(TurnData& turnData);
 	/**
 	 * @brief Check if there is less than two players alive.
-	 * 
-	 * @return The action performed.
 	 */
-	CoreActionPtr checkIsGameOver(TurnData& turnData);
+	void checkIsGameOver(TurnData& turnData);
 	/**
 	 * @brief Removes the collected bonuses.
-	 * 
-	 * @return The action performed.
 	 */
-	CoreActionPtr clearBonuses(TurnData& turnData);
+	void clearBonuses(TurnData& turnData);
 	/**
 	 * @brief Attempts to generate new bonuses.
-	 * 
-	 * @return The action performed.
 	 */
-	CoreActionPtr generateBonus(TurnData& turnData);
+	void generateBonus(TurnData& turnData);
 	
 	/**
-	 * @brief Finds collisions of the given player and other players.
+	 * @brief Finds collisions between all pairs of players.
 	 * 
-	 * @return The action performed.
+	 * @details Candidate pairs are found by sorting the players' trajectory
+	 *          bounding boxes along the X axis and sweeping over them. Each
+	 *          pair is tested only once and the collision is added to both
+	 *          players. The sweep may run in parallel; the collisions are
+	 *          added afterwards in the order of the serial sweep.
 	 */
-	CoreActionPtr findPlayerPlayerCollisions(PlayerId id,
-		PlayerTurn& playerTurn, TurnData& turnData);
+	void findPlayerPlayerCollisions(TurnData& turnData);
 	/**
 	 * @brief Finds collisions of the given player and bonuses.
-	 * 
-	 * @return The action performed.
 	 */
-	CoreActionPtr findPlayerBonusCollisions(PlayerId id,
-		PlayerTurn& playerTurn, TurnData& turnData);
+	void findPlayerBonusCollisions(PlayerId id, PlayerTurn& playerTurn);
 	/**
 	 * @brief Updates the position of the given player.
 	 * 
-	 * @return The action performed.
+	 * @details The change is reported by `changePlayerHp()`.
 	 */
-	CoreActionPtr movePlayer(PlayerId id,
+	void movePlayer(PlayerId id,
 		PlayerTurn& playerTurn, TurnData& turnData);
 	/**
 	 * @brief Updates the health points of the given player.
-	 * 
-	 * @return The action performed.
 	 */
-	CoreActionPtr changePlayerHp(PlayerId id,
+	void changePlayerHp(PlayerId id,
 		PlayerTurn& playerTurn, TurnData& turnData);
 	/**
-	 * @brief Updates the active bonus effects of the given player.
+	 * @brief Calculates the health points of a player at the end of a tick.
 	 * 
-	 * @return The action performed.
+	 * @details Shared with `ForwardModel`, so both apply the same rules in the
+	 *          same order (the result depends on the order of the
+	 *          floating-point operations).
+	 * 
+	 * @param obstacles
+	 * @param pos Position of the player at the end of the tick.
+	 * @param hp Health points at the start of the tick.
+	 * @param collisions Collisions with the other players sorted by the
+	 *                   opponent ID.
+	 * @param effectHpChange Change of the health points by the bonus effects.
+	 * @param isDeflating Whether the player deflates.
+	 */
+	static double getNewPlayerHp(const StageObstacles& obstacles,
+		const Point_2& pos, double hp,
+		const std::vector<PlayerCollision>& collisions, double effectHpChange,
+		bool isDeflating);
+	/**
+	 * @brief Updates the active bonus effects of the given player.
 	 */
-	CoreActionPtr applyPlayerBonusCollisions(PlayerId id,
+	void applyPlayerBonusCollisions(PlayerId id,
 		PlayerTurn& playerTurn, TurnData& turnData);
 
-	static Timer createNewBonusTimer();
-	void resetBonusTimer();
+	/**
+	 * @brief Randomly generates the number of ticks until a new bonus may be
+	 *        generated.
+	 */
+	size_t createNewBonusCountdown();
+	void resetBonusCountdown();
 
+	/**
+	 * @brief Updates the game state proxy and lets the agents plan.
+	 * 
+	 * @details If the agents plan in parallel, the planning is only prepared;
+	 *          it is started by `startAgentPlanning()`.
+	 */
 	void notifyAgents();
+	/**
+	 * @brief Checks whether the agents plan on the worker pool (in parallel
+	 *        with each other and with the rest of the game loop).
+	 */
+	bool isAgentPlanningParallel() const;
+	/**
+	 * @brief Plans the agents `[begin, end)`.
+	 */
+	void planAgents(size_t begin, size_t end);
+	/**
+	 * @brief Starts the parallel planning of the agents prepared by
+	 *        `notifyAgents()`.
+	 */
+	void startAgentPlanning();
+	/**
+	 * @brief Waits until the agents finish planning.
+	 * 
+	 * @details The agents read the game state while planning, so this must
+	 *          be called before changing it.
+	 */
+	void joinAgents();
 
 	/**
-	 * @brief Calculates the size (radius) of the player based on their HP.
+	 * @brief Returns the size (radius) of the player.
 	 */
 	double getPlayerSize(PlayerId id) const;
 	/**
@@ -285,8 +498,7 @@ private:
 	 */
 	static double getPlayerSize(double hp);
 	/**
-	 * @brief Calculates the speed (steps per millisecond) of the player based
-	 *        on their HP.
+	 * @brief Returns the speed (steps per millisecond) of the player.
 	 */
 	double getPlayerSpeed(PlayerId id) const;
 	/**
@@ -295,8 +507,8 @@ private:
 	 */
 	static double getPlayerSpeed(double hp);
 	/**
-	 * @brief Calculates the strength (damage dealt per millisecond) of the
-	 *        player based on their HP.
+	 * @brief Returns the strength (damage dealt per millisecond) of the
+	 *        player.
 	 */
 	double getPlayerStrength(PlayerId id) const;
 	/**
@@ -320,6 +532,27 @@ public:
 	 * @brief Constructs a new Core object.
 	 */
 	Core(const GameSetupData& gsdata);
+	/**
+	 * @brief Constructs a branch of another core.
+	 * 
+	 * @details The new core continues from the current state of `source`
+	 *          but with its own inputs and AI agents. The static stage data
+	 *          are shared, so they are not re-created. The core is initialized
+	 *          right away, so the first `step()` call already executes a tick.
+	 * 
+	 * @param gsdata Setup of the branch. The stage and the number of players
+	 *               must be the same as the source's. Must not be a replay nor
+	 *               be recorded.
+	 * @param source An initialized core.
+	 */
+	Core(const GameSetupData& gsdata, const Core& source);
+	/**
+	 * @brief Destroys the Core object.
+	 * 
+	 * @details Waits for the agents planning in the background (the planning
+	 *          uses the members destroyed before the worker pool).
+	 */
+	~Core();
 	/**
 	 * @brief Quits the core.
 	 * 
@@ -330,9 +563,79 @@ public:
 	/**
 	 * @brief Event that happens every event loop iteration.
 	 * 
-	 * @return The action performed.
+	 * @details Executes as many ticks as needed to keep up with the real time
+	 *          (at most `MAX_CATCH_UP_TICKS`, or less while overloaded,
+	 *          depending on the degradation policy). The events of the ticks are
+	 *          coalesced, so the receiver gets one update per player even if
+	 *          several ticks were executed.
+	 * 
+	 * @return The events of this iteration. Valid until the next call of
+	 *         `loopEvent()`, `step()`, or `restoreSnapshot()`.
+	 */
+	const CoreEventBuffer& loopEvent();
+	/**
+	 * @brief Advances the game by exactly one tick, regardless of the real time
+	 *        elapsed.
+	 * 
+	 * @details The first call initializes the stage (same as the first call
+	 *          of `loopEvent()`). Used by headless drivers which run the
+	 *          simulation as fast as possible.
+	 * 
+	 * @return The events of this tick. Valid until the next call of
+	 *         `loopEvent()`, `step()`, or `restoreSnapshot()`.
+	 */
+	const CoreEventBuffer& step();
+	/**
+	 * @brief Checks whether the game is over (less than two players alive).
+	 */
+	bool isOver() const;
+	/**
+	 * @brief Returns the timing metrics of the tick scheduling.
+	 * 
+	 * @details Only relevant if the game is driven by `loopEvent()`.
+	 */
+	const TickScheduler::Metrics& getTickMetrics() const;
+	/**
+	 * @brief Returns the profiler of the tick phases.
+	 * 
+	 * @details Can be queried at any time, e.g., to find out which phase is
+	 *          responsible for the missed tick deadlines.
+	 */
+	TickProfiler& getTickProfiler();
+	const TickProfiler& getTickProfiler() const;
+	/**
+	 * @brief Returns the watchdog of the tick budget.
+	 * 
+	 * @details Tells which ticks have overrun the budget and why.
+	 */
+	const TickWatchdog& getTickWatchdog() const;
+	/**
+	 * @brief Returns the number of ticks since the start of the game.
+	 */
+	uint64_t getTickCount() const;
+	/**
+	 * @brief Stores the current state of the game to `out`.
+	 * 
+	 * @details The buffers of `out` are reused, so taking a snapshot into the
+	 *          same object every tick does not allocate (apart from copying
+	 *          the active bonus effects).
+	 * 
+	 * @note The core must be initialized.
+	 */
+	void saveSnapshot(Snapshot& out) const;
+	/**
+	 * @brief Sets the state of the game to `snapshot`.
+	 * 
+	 * @details The snapshot must have been taken by this core or by a core
+	 *          with the same setup. A replay is moved to the tick of the
+	 *          snapshot; a recording is cut at that tick, so only rewinding is
+	 *          possible while recording.
+	 * 
+	 * @return The events which transform the previous state to the restored
+	 *         one. Valid until the next call of `loopEvent()`, `step()`, or
+	 *         `restoreSnapshot()`.
 	 */
-	const CoreActionPtr loopEvent();
+	const CoreEventBuffer& restoreSnapshot(const Snapshot& snapshot);
 	std::unordered_map<PlayerId, PlayerState> getPlayerStates() const;
 	std::vector<StageObstacle> getObstaclesList() const;
 	Size2d getStageSize() const;
@@ -1,12 +0,0 @@
-/**
- * @file CoreAction.cpp
- * @author Tomáš Ludrovan
- * @brief CoreAction class
- * @version 0.1
- * @date 2024-03-09
- * 
- * @copyright Copyright (c) 2024
- * 
- */
-
-#include "core/CoreAction.hpp"
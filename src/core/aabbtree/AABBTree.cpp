@@ -0,0 +1,96 @@
+/**
+ * @file AABBTree.cpp
+ * @author Tomáš Ludrovan
+ * @brief AABBTree class
+ * @version 0.1
+ * @date 2024-05-09
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "core/aabbtree/AABBTree.hpp"
+
+#include <algorithm>
+
+AABBTree::AABBTree()
+{}
+
+AABBTree::AABBTree(const std::vector<CGAL::Bbox_2>& bboxes)
+{
+	if (bboxes.empty()) return;
+
+	m_primitives.resize(bboxes.size());
+	for (uint32_t i = 0; i < bboxes.size(); i++) {
+		m_primitives[i] = i;
+	}
+
+	// A binary tree with leaves of size 1 has `2n - 1` nodes
+	m_nodes.reserve(2 * bboxes.size());
+
+	build(bboxes, 0, static_cast<uint32_t>(bboxes.size()));
+}
+
+uint32_t AABBTree::build(const std::vector<CGAL::Bbox_2>& bboxes,
+	uint32_t begin, uint32_t end)
+{
+	uint32_t nodeIdx = static_cast<uint32_t>(m_nodes.size());
+	m_nodes.push_back(Node());
+
+	// Bounding box of the node; also the bounding box of the centers of the
+	// primitives, which is used for choosing the split axis
+	CGAL::Bbox_2 bbox = bboxes[m_primitives[begin]];
+	double cxmin, cymin, cxmax, cymax;
+	cxmin = cxmax = (bbox.xmin() + bbox.xmax()) / 2.0;
+	cymin = cymax = (bbox.ymin() + bbox.ymax()) / 2.0;
+	for (uint32_t i = begin + 1; i < end; i++) {
+		const auto& primBbox = bboxes[m_primitives[i]];
+		double cx = (primBbox.xmin() + primBbox.xmax()) / 2.0;
+		double cy = (primBbox.ymin() + primBbox.ymax()) / 2.0;
+
+		bbox += primBbox;
+		cxmin = std::min(cxmin, cx);
+		cxmax = std::max(cxmax, cx);
+		cymin = std::min(cymin, cy);
+		cymax = std::max(cymax, cy);
+	}
+
+	if (end - begin <= MAX_LEAF_SIZE) {
+		// Leaf
+
+		m_nodes[nodeIdx] = Node{
+			bbox, // bbox
+			begin, // offset
+			end - begin, // count
+		};
+	} else {
+		// Inner node -- split in the median along the longer axis
+
+		bool splitX = (cxmax - cxmin >= cymax - cymin);
+		uint32_t mid = begin + (end - begin) / 2;
+
+		std::nth_element(
+			m_primitives.begin() + begin,
+			m_primitives.begin() + mid,
+			m_primitives.begin() + end,
+			[&bboxes, splitX](uint32_t lhs, uint32_t rhs) {
+				const auto& l = bboxes[lhs];
+				const auto& r = bboxes[rhs];
+				return splitX
+					? (l.xmin() + l.xmax() < r.xmin() + r.xmax())
+					: (l.ymin() + l.ymax() < r.ymin() + r.ymax());
+			}
+		);
+
+		build(bboxes, begin, mid);
+		uint32_t rightIdx = build(bboxes, mid, end);
+
+		m_nodes[nodeIdx] = Node{
+			bbox, // bbox
+			rightIdx, // offset
+			0, // count
+		};
+	}
+
+	return nodeIdx;
+}
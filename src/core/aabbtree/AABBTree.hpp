@@ -0,0 +1,120 @@
+/**
+ * @file AABBTree.hpp
+ * @author Tomáš Ludrovan
+ * @brief AABBTree class
+ * @version 0.1
+ * @date 2024-05-09
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef AABBTREE_HPP
+#define AABBTREE_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "core/geometry/Geometry.hpp"
+
+/**
+ * @brief Static bounding volume hierarchy of axis-aligned bounding boxes.
+ * 
+ * @details The tree is built once from a list of bounding boxes of some
+ *          primitives (e.g. triangles) and it may not be modified afterwards.
+ *          The primitives themselves are not stored in the tree, they are
+ *          referred to by their indexes in the list.
+ * 
+ *          The nodes are stored in a flat array in depth-first order; the left
+ *          child of an inner node immediately follows its parent.
+ */
+class AABBTree {
+private:
+	// Maximum number of primitives in a leaf
+	static constexpr uint32_t MAX_LEAF_SIZE = 2;
+	// Maximum tree depth (the tree is balanced, so this is plenty)
+	static constexpr size_t MAX_DEPTH = 64;
+
+	struct Node {
+		CGAL::Bbox_2 bbox;
+		// Leaf: index of the first primitive in `m_primitives`
+		// Inner node: index of the right child
+		uint32_t offset;
+		// Number of primitives; zero for inner nodes
+		uint32_t count;
+	};
+
+	std::vector<Node> m_nodes;
+	// Primitive indexes ordered so that each leaf refers to a continuous range
+	std::vector<uint32_t> m_primitives;
+
+	/**
+	 * @brief Recursively builds the subtree over `m_primitives[begin, end)`.
+	 * 
+	 * @return Index of the subtree root node.
+	 */
+	uint32_t build(const std::vector<CGAL::Bbox_2>& bboxes, uint32_t begin,
+		uint32_t end);
+public:
+	/**
+	 * @brief Constructs an empty AABBTree object.
+	 */
+	AABBTree();
+	/**
+	 * @brief Constructs a new AABBTree object.
+	 * 
+	 * @param bboxes Bounding boxes of the primitives.
+	 */
+	AABBTree(const std::vector<CGAL::Bbox_2>& bboxes);
+
+	/**
+	 * @brief Calls `visitor` for every primitive whose bounding box overlaps
+	 *        `box`.
+	 * 
+	 * @tparam Visitor Callable with signature `bool(size_t idx)`. If it returns
+	 *                 `false`, the query stops.
+	 * @return `false` if the query has been stopped by the visitor, `true`
+	 *         otherwise.
+	 */
+	template <typename Visitor>
+	bool query(const CGAL::Bbox_2& box, Visitor visitor) const;
+};
+
+template <typename Visitor>
+bool AABBTree::query(const CGAL::Bbox_2& box, Visitor visitor) const
+{
+	if (m_nodes.empty()) return true;
+
+	uint32_t stack[MAX_DEPTH];
+	size_t stackSize = 0;
+
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		const Node& node = m_nodes[stack[--stackSize]];
+
+		if (!CGAL::do_overlap(node.bbox, box)) continue;
+
+		if (node.count > 0) {
+			// Leaf
+
+			for (uint32_t i = node.offset; i < node.offset + node.count; i++) {
+				if (!visitor(static_cast<size_t>(m_primitives[i]))) {
+					return false;
+				}
+			}
+		} else {
+			// Inner node
+
+			assert(stackSize + 2 <= MAX_DEPTH);
+			uint32_t nodeIdx = static_cast<uint32_t>(&node - m_nodes.data());
+			stack[stackSize++] = node.offset;   // right child
+			stack[stackSize++] = nodeIdx + 1;   // left child
+		}
+	}
+
+	return true;
+}
+
+#endif // AABBTREE_HPP
@@ -1,7 +1,7 @@
 /**
  * @file BonusEffect.cpp
  * @author Tomáš Ludrovan
- * @brief BonusEffect class
+ * @brief Bonus effect pools
  * @version 0.1
  * @date 2024-03-15
  * 
@@ -10,3 +10,157 @@
  */
 
 #include "core/bonuseffect/BonusEffect.hpp"
+
+void BonusEffectHpPool::removeAt(size_t idx)
+{
+	m_players[idx] = m_players.back();
+	m_recoveryToGo[idx] = m_recoveryToGo.back();
+	m_players.pop_back();
+	m_recoveryToGo.pop_back();
+}
+
+void BonusEffectHpPool::add(PlayerId id, HpRecovery recovery)
+{
+	m_players.push_back(id);
+	m_recoveryToGo.push_back(hpRecoveryToValue(recovery));
+}
+
+std::unique_ptr<BonusEffectPool> BonusEffectHpPool::clone() const
+{
+	return std::make_unique<BonusEffectHpPool>(*this);
+}
+
+void BonusEffectHpPool::assign(const BonusEffectPool& other)
+{
+	const auto& otherHp = static_cast<const BonusEffectHpPool&>(other);
+	m_players = otherHp.m_players;
+	m_recoveryToGo = otherHp.m_recoveryToGo;
+}
+
+void BonusEffectHpPool::applyEffects(std::vector<EffectAttributes>& attrs)
+{
+	static constexpr double RECOVERY_PER_TICK = RECOVERY_PER_MS * TICK_INTERVAL;
+
+	size_t i = 0;
+	while (i < m_players.size()) {
+		double& recoveryToGo = m_recoveryToGo[i];
+		double recoveryAmount = RECOVERY_PER_TICK;
+		if (recoveryAmount > recoveryToGo) {
+			recoveryAmount = recoveryToGo;
+		}
+
+		attrs[m_players[i]].addAttributeChangeHp(recoveryAmount);
+
+		recoveryToGo -= recoveryAmount;
+
+		if (recoveryToGo > 0.0) {
+			i++;
+		} else {
+			// The effect has run out -- the last one takes its place (and is
+			// processed next)
+			removeAt(i);
+		}
+	}
+}
+
+void BonusEffectHpPool::removePlayer(PlayerId id)
+{
+	size_t i = 0;
+	while (i < m_players.size()) {
+		if (m_players[i] == id) {
+			removeAt(i);
+		} else {
+			i++;
+		}
+	}
+}
+
+void BonusEffectHpPool::clear()
+{
+	m_players.clear();
+	m_recoveryToGo.clear();
+}
+
+size_t BonusEffectHpPool::size() const
+{
+	return m_players.size();
+}
+
+BonusEffectSystem::BonusEffectSystem()
+{
+	Kind kindHp = registerKind(std::make_unique<BonusEffectHpPool>());
+	assert(kindHp == KIND_HP);
+	(void)kindHp;
+}
+
+BonusEffectSystem::BonusEffectSystem(const BonusEffectSystem& other)
+{
+	m_pools.reserve(other.m_pools.size());
+	for (const auto& pool : other.m_pools) {
+		m_pools.push_back(pool->clone());
+	}
+}
+
+BonusEffectSystem& BonusEffectSystem::operator=(
+	const BonusEffectSystem& other)
+{
+	if (this == &other) return *this;
+
+	// Registered kinds are never removed, so the same count means the same
+	// kinds (if both have been set up the same way)
+	if (m_pools.size() == other.m_pools.size()) {
+		for (size_t kind = 0; kind < m_pools.size(); kind++) {
+			m_pools[kind]->assign(*other.m_pools[kind]);
+		}
+	} else {
+		m_pools.clear();
+		for (const auto& pool : other.m_pools) {
+			m_pools.push_back(pool->clone());
+		}
+	}
+
+	return *this;
+}
+
+BonusEffectSystem::Kind BonusEffectSystem::registerKind(
+	std::unique_ptr<BonusEffectPool> pool)
+{
+	m_pools.push_back(std::move(pool));
+	return m_pools.size() - 1;
+}
+
+BonusEffectPool& BonusEffectSystem::getPool(Kind kind)
+{
+	return *m_pools[kind];
+}
+
+const BonusEffectPool& BonusEffectSystem::getPool(Kind kind) const
+{
+	return *m_pools[kind];
+}
+
+BonusEffectHpPool& BonusEffectSystem::getHpPool()
+{
+	return static_cast<BonusEffectHpPool&>(*m_pools[KIND_HP]);
+}
+
+void BonusEffectSystem::applyEffects(std::vector<EffectAttributes>& attrs)
+{
+	for (auto& pool : m_pools) {
+		pool->applyEffects(attrs);
+	}
+}
+
+void BonusEffectSystem::removePlayer(PlayerId id)
+{
+	for (auto& pool : m_pools) {
+		pool->removePlayer(id);
+	}
+}
+
+void BonusEffectSystem::clear()
+{
+	for (auto& pool : m_pools) {
+		pool->clear();
+	}
+}
@@ -1,12 +1,16 @@
 /**
  * @file BonusEffect.hpp
  * @author Tomáš Ludrovan
- * @brief BonusEffect class
+ * @brief Bonus effect pools
  * @version 0.1
  * @date 2024-03-15
  * 
  * @copyright Copyright (c) 2024
  * 
+ * @details The active effects are stored per effect kind in packed arrays
+ *          (one pool per kind), so they are updated in bulk, and an effect
+ *          is removed by moving the last one to its place. Adding an effect
+ *          does not allocate once the arrays have grown enough.
  */
 
 #ifndef BONUSEFFECT_HPP
@@ -14,18 +18,54 @@
 
 #include <cassert>
 #include <memory>
+#include <vector>
 
 #include "core/Common.hpp"
 #include "core/bonuseffect/EffectAttributes.hpp"
 
-class BonusEffect {
+/**
+ * @brief Active effects of one kind (of all the players).
+ */
+class BonusEffectPool {
 public:
-	virtual ~BonusEffect() {}
-	virtual void applyEffect(EffectAttributes& attrs) = 0;
-	virtual bool isActive() = 0;
+	virtual ~BonusEffectPool() {}
+	/**
+	 * @brief Creates a copy of the pool (including the progress of the
+	 *        effects).
+	 */
+	virtual std::unique_ptr<BonusEffectPool> clone() const = 0;
+	/**
+	 * @brief Sets the effects to the ones of `other`.
+	 * 
+	 * @details Reuses the buffers.
+	 * 
+	 * @param other Pool of the same kind.
+	 */
+	virtual void assign(const BonusEffectPool& other) = 0;
+	/**
+	 * @brief Applies the effects for one tick and removes the expired ones.
+	 * 
+	 * @param attrs Attributes indexed by the player ID.
+	 */
+	virtual void applyEffects(std::vector<EffectAttributes>& attrs) = 0;
+	/**
+	 * @brief Removes all the effects of the player.
+	 */
+	virtual void removePlayer(PlayerId id) = 0;
+	/**
+	 * @brief Removes all the effects.
+	 */
+	virtual void clear() = 0;
+	/**
+	 * @brief Returns the number of active effects.
+	 */
+	virtual size_t size() const = 0;
 };
 
-class BonusEffectHp : public BonusEffect {
+/**
+ * @brief HP recovery effects.
+ */
+class BonusEffectHpPool : public BonusEffectPool {
 public:
 	enum HpRecovery {
 		RECOVER_25,
@@ -47,26 +87,78 @@ public:
 private:
 	static constexpr double RECOVERY_PER_MS = 0.8 / 1000.0;
 
-	double m_recoveryToGo;
+	// Indexed by the effect
+	std::vector<PlayerId> m_players;
+	std::vector<double> m_recoveryToGo;
+
+	/**
+	 * @brief Removes the effect by moving the last one to its place.
+	 */
+	void removeAt(size_t idx);
 public:
-	BonusEffectHp(HpRecovery recovery)
-		: m_recoveryToGo{hpRecoveryToValue(recovery)}
-	{}
+	/**
+	 * @brief Adds an effect to the player.
+	 */
+	void add(PlayerId id, HpRecovery recovery);
 
-	void applyEffect(EffectAttributes& attrs) override {
-		double recoveryAmount = RECOVERY_PER_MS * TICK_INTERVAL;
-		if (recoveryAmount > m_recoveryToGo) {
-			recoveryAmount = m_recoveryToGo;
-		}
+	std::unique_ptr<BonusEffectPool> clone() const override;
+	void assign(const BonusEffectPool& other) override;
+	void applyEffects(std::vector<EffectAttributes>& attrs) override;
+	void removePlayer(PlayerId id) override;
+	void clear() override;
+	size_t size() const override;
+};
+
+/**
+ * @brief Active effects of all kinds.
+ * 
+ * @details Each kind is registered once and then referred to by its index.
+ *          Copying the object copies the effects.
+ */
+class BonusEffectSystem {
+public:
+	typedef size_t Kind;
 
-		attrs.addAttributeChangeHp(recoveryAmount);
+	// Built-in kinds
+	static constexpr Kind KIND_HP = 0;
+private:
+	std::vector<std::unique_ptr<BonusEffectPool>> m_pools;
+public:
+	/**
+	 * @brief Constructs a new object with the built-in kinds registered.
+	 */
+	BonusEffectSystem();
+	BonusEffectSystem(const BonusEffectSystem& other);
+	/**
+	 * @brief Copies the effects of `other`.
+	 * 
+	 * @details The buffers are reused if both objects have the same kinds.
+	 */
+	BonusEffectSystem& operator=(const BonusEffectSystem& other);
 
-		m_recoveryToGo -= recoveryAmount;
-	}
+	/**
+	 * @brief Registers a new effect kind.
+	 * 
+	 * @return Index of the kind.
+	 */
+	Kind registerKind(std::unique_ptr<BonusEffectPool> pool);
+	BonusEffectPool& getPool(Kind kind);
+	const BonusEffectPool& getPool(Kind kind) const;
+	BonusEffectHpPool& getHpPool();
 
-	bool isActive() override {
-		return (m_recoveryToGo > 0.0);
-	}
+	/**
+	 * @brief Applies the effects of all kinds for one tick (see
+	 *        `BonusEffectPool::applyEffects()`).
+	 */
+	void applyEffects(std::vector<EffectAttributes>& attrs);
+	/**
+	 * @brief Removes all the effects of the player.
+	 */
+	void removePlayer(PlayerId id);
+	/**
+	 * @brief Removes all the effects.
+	 */
+	void clear();
 };
 
 #endif // BONUSEFFECT_HPP
@@ -0,0 +1,240 @@
+/**
+ * @file CoreEvent.cpp
+ * @author Tomáš Ludrovan
+ * @brief CoreEvent structure and CoreEventBuffer class
+ * @version 0.1
+ * @date 2024-05-14
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "core/coreevent/CoreEvent.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+CoreEvent& CoreEventBuffer::push(CoreEvent::Type type)
+{
+	m_events.emplace_back();
+	CoreEvent& res = m_events.back();
+	res.type = type;
+	return res;
+}
+
+void CoreEventBuffer::clear()
+{
+	m_events.clear();
+	m_obstacleShapes.clear();
+}
+
+void CoreEventBuffer::coalesce()
+{
+	// Flags of `m_playerSeen`
+	static constexpr unsigned SEEN_POS = 1u << 0;
+	static constexpr unsigned SEEN_HP = 1u << 1;
+	static constexpr unsigned SEEN_SIZE = 1u << 2;
+	static constexpr unsigned SEEN_REMOVE = 1u << 3;
+
+	m_keep.assign(m_events.size(), true);
+	m_playerSeen.clear();
+	m_removedBonuses.clear();
+
+	// Returns true if the event should be kept and marks it as seen
+	auto markPlayer = [this](PlayerId id, unsigned flag) {
+		if (id >= m_playerSeen.size()) {
+			m_playerSeen.resize(id + 1, 0);
+		}
+		bool res = !(m_playerSeen[id] & (flag | SEEN_REMOVE));
+		m_playerSeen[id] |= flag;
+		return res;
+	};
+
+	// Backwards, so the later events are known
+	for (size_t i = m_events.size(); i-- > 0;) {
+		const auto& e = m_events[i];
+
+		switch (e.type) {
+			case CoreEvent::EVENT_REMOVE_PLAYER:
+				markPlayer(e.player.id, SEEN_REMOVE);
+				break;
+			case CoreEvent::EVENT_ADD_PLAYER:
+				// The player (re)appears -- the earlier events are relevant
+				// again
+				if (e.player.id < m_playerSeen.size()) {
+					m_playerSeen[e.player.id] = 0;
+				}
+				break;
+			case CoreEvent::EVENT_SET_PLAYER_POS:
+				m_keep[i] = markPlayer(e.setPlayerPos.id, SEEN_POS);
+				break;
+			case CoreEvent::EVENT_SET_PLAYER_HP:
+				m_keep[i] = markPlayer(e.setPlayerValue.id, SEEN_HP);
+				break;
+			case CoreEvent::EVENT_SET_PLAYER_SIZE:
+				m_keep[i] = markPlayer(e.setPlayerValue.id, SEEN_SIZE);
+				break;
+			case CoreEvent::EVENT_REMOVE_BONUS:
+				m_removedBonuses.emplace_back(e.removeBonus.id, i);
+				break;
+			case CoreEvent::EVENT_ADD_BONUS: {
+				auto iter = std::find_if(m_removedBonuses.begin(),
+					m_removedBonuses.end(),
+					[&e](const auto& removed) {
+						return removed.first == e.addBonus.id;
+					});
+				if (iter != m_removedBonuses.end()) {
+					// Never seen by the receiver
+					m_keep[i] = false;
+					m_keep[iter->second] = false;
+					m_removedBonuses.erase(iter);
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	// Compact
+	size_t count = 0;
+	for (size_t i = 0; i < m_events.size(); i++) {
+		if (m_keep[i]) {
+			m_events[count++] = m_events[i];
+		}
+	}
+	m_events.resize(count);
+}
+
+const PolygonF& CoreEventBuffer::getObstacleShape(const CoreEvent& e) const
+{
+	assert(e.type == CoreEvent::EVENT_ADD_OBSTACLE);
+	return m_obstacleShapes[e.addObstacle.shapeIdx];
+}
+
+void CoreEventBuffer::pushAddObstacle(const PolygonF& shape)
+{
+	push(CoreEvent::EVENT_ADD_OBSTACLE).addObstacle = {
+		m_obstacleShapes.size(), // shapeIdx
+	};
+	m_obstacleShapes.push_back(shape);
+}
+
+void CoreEventBuffer::pushSetStageSize(const Size2d& size)
+{
+	push(CoreEvent::EVENT_SET_STAGE_SIZE).setStageSize = {
+		size.w, // w
+		size.h, // h
+	};
+}
+
+void CoreEventBuffer::pushAddPlayer(PlayerId id)
+{
+	push(CoreEvent::EVENT_ADD_PLAYER).player = {id};
+}
+
+void CoreEventBuffer::pushRemovePlayer(PlayerId id)
+{
+	push(CoreEvent::EVENT_REMOVE_PLAYER).player = {id};
+}
+
+void CoreEventBuffer::pushSetPlayerPos(PlayerId id, const PointF& pos)
+{
+	push(CoreEvent::EVENT_SET_PLAYER_POS).setPlayerPos = {
+		id, // id
+		pos.x, // x
+		pos.y, // y
+	};
+}
+
+void CoreEventBuffer::pushSetPlayerHp(PlayerId id, double hp)
+{
+	push(CoreEvent::EVENT_SET_PLAYER_HP).setPlayerValue = {
+		id, // id
+		hp, // value
+	};
+}
+
+void CoreEventBuffer::pushSetPlayerSize(PlayerId id, double size)
+{
+	push(CoreEvent::EVENT_SET_PLAYER_SIZE).setPlayerValue = {
+		id, // id
+		size, // value
+	};
+}
+
+void CoreEventBuffer::pushAddBonus(BonusId id, const PointF& pos)
+{
+	push(CoreEvent::EVENT_ADD_BONUS).addBonus = {
+		id, // id
+		pos.x, // x
+		pos.y, // y
+	};
+}
+
+void CoreEventBuffer::pushRemoveBonus(BonusId id, double hpRecovery,
+	bool isCollected)
+{
+	push(CoreEvent::EVENT_REMOVE_BONUS).removeBonus = {
+		id, // id
+		hpRecovery, // hpRecovery
+		isCollected, // isCollected
+	};
+}
+
+void CoreEventBuffer::pushAnnounceWinner(PlayerId id)
+{
+	push(CoreEvent::EVENT_ANNOUNCE_WINNER).player = {id};
+}
+
+void CoreEventBuffer::pushAnnounceDrawGame()
+{
+	push(CoreEvent::EVENT_ANNOUNCE_DRAW_GAME);
+}
+
+void CoreEventBuffer::visit(ICoreEventVisitor& visitor) const
+{
+	for (const auto& e : m_events) {
+		switch (e.type) {
+			case CoreEvent::EVENT_ADD_OBSTACLE:
+				visitor.onAddObstacle(getObstacleShape(e));
+				break;
+			case CoreEvent::EVENT_SET_STAGE_SIZE:
+				visitor.onSetStageSize(Size2d(e.setStageSize.w,
+					e.setStageSize.h));
+				break;
+			case CoreEvent::EVENT_ADD_PLAYER:
+				visitor.onAddPlayer(e.player.id);
+				break;
+			case CoreEvent::EVENT_REMOVE_PLAYER:
+				visitor.onRemovePlayer(e.player.id);
+				break;
+			case CoreEvent::EVENT_SET_PLAYER_POS:
+				visitor.onSetPlayerPos(e.setPlayerPos.id,
+					PointF(e.setPlayerPos.x, e.setPlayerPos.y));
+				break;
+			case CoreEvent::EVENT_SET_PLAYER_HP:
+				visitor.onSetPlayerHp(e.setPlayerValue.id,
+					e.setPlayerValue.value);
+				break;
+			case CoreEvent::EVENT_SET_PLAYER_SIZE:
+				visitor.onSetPlayerSize(e.setPlayerValue.id,
+					e.setPlayerValue.value);
+				break;
+			case CoreEvent::EVENT_ADD_BONUS:
+				visitor.onAddBonus(e.addBonus.id,
+					PointF(e.addBonus.x, e.addBonus.y));
+				break;
+			case CoreEvent::EVENT_REMOVE_BONUS:
+				visitor.onRemoveBonus(e.removeBonus.id,
+					e.removeBonus.hpRecovery, e.removeBonus.isCollected);
+				break;
+			case CoreEvent::EVENT_ANNOUNCE_WINNER:
+				visitor.onAnnounceWinner(e.player.id);
+				break;
+			case CoreEvent::EVENT_ANNOUNCE_DRAW_GAME:
+				visitor.onAnnounceDrawGame();
+				break;
+		}
+	}
+}
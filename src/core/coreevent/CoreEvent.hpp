@@ -0,0 +1,187 @@
+/**
+ * @file CoreEvent.hpp
+ * @author Tomáš Ludrovan
+ * @brief CoreEvent structure and CoreEventBuffer class
+ * @version 0.1
+ * @date 2024-05-14
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef COREEVENT_HPP
+#define COREEVENT_HPP
+
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+#include "core/Common.hpp"
+
+/**
+ * @brief Change of the game state reported by the core.
+ * 
+ * @details A plain record (no heap allocations); the payload depends on the
+ *          event type. The events are stored in a `CoreEventBuffer`.
+ */
+struct CoreEvent {
+	enum Type {
+		// An obstacle was added. Happens only when the game starts.
+		EVENT_ADD_OBSTACLE,
+		// Size of the stage has changed. Happens only when the game starts.
+		EVENT_SET_STAGE_SIZE,
+		// A player joined the game
+		EVENT_ADD_PLAYER,
+		// A player has been eliminated
+		EVENT_REMOVE_PLAYER,
+		// A player has moved
+		EVENT_SET_PLAYER_POS,
+		// The number of player health points has changed
+		EVENT_SET_PLAYER_HP,
+		// Player size has changed
+		EVENT_SET_PLAYER_SIZE,
+		// A bonus has spawned
+		EVENT_ADD_BONUS,
+		// A bonus has been picked up (or has disappeared because a previous
+		// state was restored)
+		EVENT_REMOVE_BONUS,
+		// Player won the game
+		EVENT_ANNOUNCE_WINNER,
+		// All players have been eliminated
+		EVENT_ANNOUNCE_DRAW_GAME,
+	};
+
+	struct AddObstacle {
+		// Index of the shape in the buffer
+		size_t shapeIdx;
+	};
+	struct SetStageSize {
+		int w;
+		int h;
+	};
+	struct PlayerRef {
+		PlayerId id;
+	};
+	struct SetPlayerPos {
+		PlayerId id;
+		double x;
+		double y;
+	};
+	struct SetPlayerValue {
+		PlayerId id;
+		double value;
+	};
+	struct AddBonus {
+		BonusId id;
+		double x;
+		double y;
+	};
+	struct RemoveBonus {
+		BonusId id;
+		double hpRecovery;
+		// False if the bonus has not been picked up by a player
+		bool isCollected;
+	};
+
+	Type type;
+	union {
+		AddObstacle addObstacle;
+		SetStageSize setStageSize;
+		// EVENT_ADD_PLAYER, EVENT_REMOVE_PLAYER, EVENT_ANNOUNCE_WINNER
+		PlayerRef player;
+		SetPlayerPos setPlayerPos;
+		// EVENT_SET_PLAYER_HP, EVENT_SET_PLAYER_SIZE
+		SetPlayerValue setPlayerValue;
+		AddBonus addBonus;
+		RemoveBonus removeBonus;
+	};
+};
+
+/**
+ * @brief Receiver of the core events.
+ */
+class ICoreEventVisitor {
+public:
+	virtual ~ICoreEventVisitor() {}
+
+	virtual void onAddObstacle(const PolygonF& shape) = 0;
+	virtual void onSetStageSize(const Size2d& size) = 0;
+	virtual void onAddPlayer(PlayerId id) = 0;
+	virtual void onRemovePlayer(PlayerId id) = 0;
+	virtual void onSetPlayerPos(PlayerId id, const PointF& pos) = 0;
+	virtual void onSetPlayerHp(PlayerId id, double hp) = 0;
+	virtual void onSetPlayerSize(PlayerId id, double size) = 0;
+	virtual void onAddBonus(BonusId id, const PointF& pos) = 0;
+	virtual void onRemoveBonus(BonusId id, double hpRecovery,
+		bool isCollected) = 0;
+	virtual void onAnnounceWinner(PlayerId id) = 0;
+	virtual void onAnnounceDrawGame() = 0;
+};
+
+/**
+ * @brief Flat list of core events.
+ * 
+ * @details The order of the events is significant. Clearing the buffer keeps
+ *          its capacity, so once the buffer has grown enough, recording the
+ *          events does not allocate any memory.
+ */
+class CoreEventBuffer {
+private:
+	std::vector<CoreEvent> m_events;
+	// Shapes of the added obstacles (the only variable-size payload)
+	std::vector<PolygonF> m_obstacleShapes;
+
+	// Scratch buffers of `coalesce()`
+	// Indexed by the event index
+	std::vector<bool> m_keep;
+	// Indexed by the player ID; which events of the player have been seen
+	// (later in the buffer)
+	std::vector<unsigned> m_playerSeen;
+	// Bonuses removed later in the buffer (ID and index of the event)
+	std::vector<std::pair<BonusId, size_t>> m_removedBonuses;
+
+	CoreEvent& push(CoreEvent::Type type);
+public:
+	/**
+	 * @brief Removes all the events.
+	 */
+	void clear();
+	/**
+	 * @brief Removes the events which are superseded by later ones.
+	 * 
+	 * @details Used when the events of several ticks are reported at once.
+	 *          Only the last position, HP, and size of each player are kept
+	 *          (none if the player is removed later), and a bonus which is
+	 *          both added and removed disappears completely. The order of the
+	 *          remaining events is kept, so visiting them results in the same
+	 *          final state as visiting all the events.
+	 */
+	void coalesce();
+	bool empty() const { return m_events.empty(); }
+	size_t size() const { return m_events.size(); }
+	const std::vector<CoreEvent>& getEvents() const { return m_events; }
+	/**
+	 * @brief Returns the shape of the obstacle added by an
+	 *        `EVENT_ADD_OBSTACLE` event.
+	 */
+	const PolygonF& getObstacleShape(const CoreEvent& e) const;
+
+	void pushAddObstacle(const PolygonF& shape);
+	void pushSetStageSize(const Size2d& size);
+	void pushAddPlayer(PlayerId id);
+	void pushRemovePlayer(PlayerId id);
+	void pushSetPlayerPos(PlayerId id, const PointF& pos);
+	void pushSetPlayerHp(PlayerId id, double hp);
+	void pushSetPlayerSize(PlayerId id, double size);
+	void pushAddBonus(BonusId id, const PointF& pos);
+	void pushRemoveBonus(BonusId id, double hpRecovery, bool isCollected);
+	void pushAnnounceWinner(PlayerId id);
+	void pushAnnounceDrawGame();
+
+	/**
+	 * @brief Passes the events to the visitor (in order).
+	 */
+	void visit(ICoreEventVisitor& visitor) const;
+};
+
+#endif // COREEVENT_HPP
@@ -0,0 +1,257 @@
+/**
+ * @file DistanceField.cpp
+ * @author Tomáš Ludrovan
+ * @brief DistanceField class
+ * @version 0.1
+ * @date 2024-05-20
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "core/distancefield/DistanceField.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "math/Math.hpp"
+
+DistanceField::DistanceField()
+	: m_stageSize(0, 0)
+	, m_cols{0}
+	, m_rows{0}
+{}
+
+DistanceField::DistanceField(const std::vector<StageObstacle>& obstacles,
+	const Size2d& stageSize)
+	: m_stageSize{stageSize}
+	// ceiling(size / CELL_SIZE)
+	, m_cols{std::max(static_cast<int>(std::ceil(stageSize.w / CELL_SIZE)),
+		1)}
+	, m_rows{std::max(static_cast<int>(std::ceil(stageSize.h / CELL_SIZE)),
+		1)}
+{
+	static constexpr double INF = std::numeric_limits<double>::infinity();
+
+	const size_t cellCount = static_cast<size_t>(m_cols) * m_rows;
+
+	// Rasterize
+	std::vector<bool> occupied(cellCount, false);
+	for (const auto& obstacle : obstacles) {
+		rasterizeObstacle(obstacle, occupied);
+	}
+
+	// Transform
+	std::vector<double> grid(cellCount);
+	for (size_t i = 0; i < cellCount; i++) {
+		grid[i] = occupied[i] ? 0.0 : INF;
+	}
+	squaredDistanceTransform(grid, m_cols, m_rows);
+
+	// Any point of the query cell and any point of the occupied cell are at
+	// most half of the diagonal away from the respective cell centers
+	const double cellDiagonal = std::sqrt(2.0) * CELL_SIZE;
+
+	m_lowerBounds.resize(cellCount);
+	for (size_t i = 0; i < cellCount; i++) {
+		double dist = std::sqrt(grid[i]) * CELL_SIZE - cellDiagonal;
+		m_lowerBounds[i] = std::max(dist, 0.0);
+	}
+}
+
+void DistanceField::rasterizeObstacle(const StageObstacle& obstacle,
+	std::vector<bool>& occupied) const
+{
+	double xmin = obstacle.corners[0].x, xmax = xmin;
+	double ymin = obstacle.corners[0].y, ymax = ymin;
+	for (int i = 1; i < obstacle.CORNER_COUNT; i++) {
+		xmin = std::min(xmin, obstacle.corners[i].x);
+		xmax = std::max(xmax, obstacle.corners[i].x);
+		ymin = std::min(ymin, obstacle.corners[i].y);
+		ymax = std::max(ymax, obstacle.corners[i].y);
+	}
+
+	// Cells overlapping with the bounding box (the neighbors included, in
+	// case the obstacle lies on the cell boundary)
+	int colBegin = std::max(static_cast<int>(std::floor(xmin / CELL_SIZE)) - 1,
+		0);
+	int colEnd = std::min(static_cast<int>(std::floor(xmax / CELL_SIZE)) + 2,
+		m_cols);
+	int rowBegin = std::max(static_cast<int>(std::floor(ymin / CELL_SIZE)) - 1,
+		0);
+	int rowEnd = std::min(static_cast<int>(std::floor(ymax / CELL_SIZE)) + 2,
+		m_rows);
+
+	for (int row = rowBegin; row < rowEnd; row++) {
+		for (int col = colBegin; col < colEnd; col++) {
+			size_t idx = static_cast<size_t>(row) * m_cols + col;
+			if (!occupied[idx] && triangleOverlapsCell(obstacle, col, row)) {
+				occupied[idx] = true;
+			}
+		}
+	}
+}
+
+bool DistanceField::triangleOverlapsCell(const StageObstacle& obstacle,
+	int col, int row)
+{
+	static constexpr double EPSILON = 1e-6;
+	const double halfSize = CELL_SIZE / 2.0 + EPSILON;
+	const double cx = (col + 0.5) * CELL_SIZE;
+	const double cy = (row + 0.5) * CELL_SIZE;
+
+	// Separating axis test; the axes are the cell edge normals and the
+	// triangle edge normals
+
+	double xmin = obstacle.corners[0].x, xmax = xmin;
+	double ymin = obstacle.corners[0].y, ymax = ymin;
+	for (int i = 1; i < obstacle.CORNER_COUNT; i++) {
+		xmin = std::min(xmin, obstacle.corners[i].x);
+		xmax = std::max(xmax, obstacle.corners[i].x);
+		ymin = std::min(ymin, obstacle.corners[i].y);
+		ymax = std::max(ymax, obstacle.corners[i].y);
+	}
+	if (xmax < cx - halfSize || xmin > cx + halfSize
+		|| ymax < cy - halfSize || ymin > cy + halfSize)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < obstacle.CORNER_COUNT; i++) {
+		const PointF& a = obstacle.corners[i];
+		const PointF& b = obstacle.corners[(i + 1) % obstacle.CORNER_COUNT];
+		double nx = a.y - b.y;
+		double ny = b.x - a.x;
+
+		double trgMin = std::numeric_limits<double>::infinity();
+		double trgMax = -trgMin;
+		for (const auto& corner : obstacle.corners) {
+			double proj = nx * corner.x + ny * corner.y;
+			trgMin = std::min(trgMin, proj);
+			trgMax = std::max(trgMax, proj);
+		}
+
+		double cellProj = nx * cx + ny * cy;
+		double cellRadius = (std::abs(nx) + std::abs(ny)) * halfSize;
+		if (trgMax < cellProj - cellRadius || trgMin > cellProj + cellRadius) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void DistanceField::distanceTransform1d(const double* f, double* d, size_t n,
+	int* v, double* z)
+{
+	static constexpr double INF = std::numeric_limits<double>::infinity();
+
+	// Index of the rightmost parabola in the lower envelope
+	int k = -1;
+
+	for (int q = 0; q < static_cast<int>(n); q++) {
+		if (f[q] == INF) continue;
+
+		double s = -INF;
+		while (k >= 0) {
+			// Intersection of the parabolas rooted at `q` and `v[k]`
+			s = ((f[q] + sqr(q)) - (f[v[k]] + sqr(v[k])))
+				/ (2.0 * (q - v[k]));
+			if (s > z[k]) break;
+			k--;
+		}
+		if (k < 0) s = -INF;
+
+		k++;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = INF;
+	}
+
+	if (k < 0) {
+		// No source
+		std::fill(d, d + n, INF);
+		return;
+	}
+
+	k = 0;
+	for (int q = 0; q < static_cast<int>(n); q++) {
+		while (z[k + 1] < q) k++;
+		d[q] = sqr(q - v[k]) + f[v[k]];
+	}
+}
+
+void DistanceField::squaredDistanceTransform(std::vector<double>& grid,
+	size_t cols, size_t rows, WorkerPool* workerPool)
+{
+	// The columns are independent of each other (and so are the rows); each
+	// chunk has its own buffers
+
+	// Columns
+	// A block of adjacent columns is copied at once, so the grid is accessed
+	// by rows rather than jumping a whole row for each value
+	const size_t blockCount =
+		(cols + COLUMN_BLOCK_SIZE - 1) / COLUMN_BLOCK_SIZE;
+	WorkerPool::runOptional(workerPool, blockCount, [&grid, cols, rows](
+		size_t chunk, size_t begin, size_t end)
+	{
+		(void)chunk;
+
+		// Stored by columns
+		std::vector<double> f(rows * COLUMN_BLOCK_SIZE);
+		std::vector<double> d(rows), z(rows + 1);
+		std::vector<int> v(rows);
+		for (size_t block = begin; block < end; block++) {
+			size_t colBegin = block * COLUMN_BLOCK_SIZE;
+			size_t blockCols = std::min(COLUMN_BLOCK_SIZE, cols - colBegin);
+
+			for (size_t row = 0; row < rows; row++) {
+				for (size_t i = 0; i < blockCols; i++) {
+					f[i * rows + row] = grid[row * cols + colBegin + i];
+				}
+			}
+			for (size_t i = 0; i < blockCols; i++) {
+				double* col = f.data() + i * rows;
+				distanceTransform1d(col, d.data(), rows, v.data(), z.data());
+				std::copy(d.begin(), d.end(), col);
+			}
+			for (size_t row = 0; row < rows; row++) {
+				for (size_t i = 0; i < blockCols; i++) {
+					grid[row * cols + colBegin + i] = f[i * rows + row];
+				}
+			}
+		}
+	});
+
+	// Rows
+	WorkerPool::runOptional(workerPool, rows, [&grid, cols](size_t chunk,
+		size_t begin, size_t end)
+	{
+		(void)chunk;
+
+		std::vector<double> f(cols), z(cols + 1);
+		std::vector<int> v(cols);
+		for (size_t row = begin; row < end; row++) {
+			double* rowData = grid.data() + row * cols;
+			std::copy(rowData, rowData + cols, f.begin());
+			distanceTransform1d(f.data(), rowData, cols, v.data(), z.data());
+		}
+	});
+}
+
+double DistanceField::getLowerBound(double x, double y) const
+{
+	// Distance from the stage bounds
+	double res = std::min({x, y, m_stageSize.w - x, m_stageSize.h - y});
+	if (!(res > 0.0)) {
+		// Outside of the stage (or on the edge)
+		return 0.0;
+	}
+
+	int col = std::min(static_cast<int>(x / CELL_SIZE), m_cols - 1);
+	int row = std::min(static_cast<int>(y / CELL_SIZE), m_rows - 1);
+
+	size_t idx = static_cast<size_t>(row) * m_cols + col;
+	return std::min(res, m_lowerBounds[idx]);
+}
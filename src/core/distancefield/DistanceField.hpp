@@ -0,0 +1,124 @@
+/**
+ * @file DistanceField.hpp
+ * @author Tomáš Ludrovan
+ * @brief DistanceField class
+ * @version 0.1
+ * @date 2024-05-20
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef DISTANCEFIELD_HPP
+#define DISTANCEFIELD_HPP
+
+#include <vector>
+
+#include "types.hpp"
+#include "core/Common.hpp"
+#include "core/geometry/Geometry.hpp"
+#include "core/workerpool/WorkerPool.hpp"
+
+/**
+ * @brief Precomputed distances from the stage obstacles.
+ * 
+ * @details The obstacles are rasterized to a grid (a cell is occupied if it
+ *          overlaps with an obstacle) and the Euclidean distance transform of
+ *          the grid gives the distance between the cells and the nearest
+ *          occupied cell. The distance is then reduced by the cell diagonal,
+ *          so it never exceeds the exact distance of any point within the
+ *          cell. The stage bounds are taken into account exactly.
+ * 
+ *          The lookup is meant for skipping the exact geometry in the open
+ *          space: if the lower bound is large enough, there is no need to
+ *          check the obstacles.
+ */
+class DistanceField {
+private:
+	// Cell width/height
+	static constexpr double CELL_SIZE = 4.0;
+	// Number of columns transformed together
+	static constexpr size_t COLUMN_BLOCK_SIZE = 16;
+
+	Size2d m_stageSize;
+	int m_cols;
+	int m_rows;
+	// Stored by rows
+	std::vector<double> m_lowerBounds;
+
+	/**
+	 * @brief Marks the cells that overlap with the obstacle.
+	 * 
+	 * @param occupied Grid of the cells (stored by rows).
+	 */
+	void rasterizeObstacle(const StageObstacle& obstacle,
+		std::vector<bool>& occupied) const;
+	/**
+	 * @brief Checks whether a triangle overlaps with the cell.
+	 * 
+	 * @details The cell is slightly inflated, so a touching triangle counts
+	 *          as overlapping even after rounding errors.
+	 */
+	static bool triangleOverlapsCell(const StageObstacle& obstacle, int col,
+		int row);
+	/**
+	 * @brief Calculates the squared distance transform of a 1D function.
+	 * 
+	 * @details The algorithm by Felzenszwalb and Huttenlocher (lower envelope
+	 *          of parabolas).
+	 * 
+	 * @param f Input values (squared distances), `n` of them.
+	 * @param d Output values, `n` of them.
+	 * @param v Scratch buffer, `n` values.
+	 * @param z Scratch buffer, `n + 1` values.
+	 */
+	static void distanceTransform1d(const double* f, double* d, size_t n,
+		int* v, double* z);
+
+	double getLowerBound(double x, double y) const;
+public:
+	/**
+	 * @brief Constructs an empty DistanceField object.
+	 * 
+	 * @details The lower bound of any point is zero.
+	 */
+	DistanceField();
+	DistanceField(const std::vector<StageObstacle>& obstacles,
+		const Size2d& stageSize);
+
+	/**
+	 * @brief Calculates the exact squared Euclidean distance transform of
+	 *        a grid.
+	 * 
+	 * @param grid Zero for the source cells, infinity for the others. Stored
+	 *             by rows. Overwritten by the squared distance (in cells) of
+	 *             each cell from the nearest source cell.
+	 * @param cols Number of columns.
+	 * @param rows Number of rows.
+	 * @param workerPool If not `nullptr`, the columns (and then the rows) are
+	 *                   transformed in parallel.
+	 */
+	static void squaredDistanceTransform(std::vector<double>& grid,
+		size_t cols, size_t rows, WorkerPool* workerPool = nullptr);
+
+	/**
+	 * @brief Returns a lower bound of the distance of the point from the
+	 *        nearest obstacle or the stage bounds.
+	 * 
+	 * @details Zero for points outside the stage.
+	 */
+	double getLowerBound(const Point_2& p) const {
+		return getLowerBound(p.x(), p.y());
+	}
+	/**
+	 * @brief Returns a lower bound of the distance of the point from the
+	 *        nearest obstacle or the stage bounds.
+	 * 
+	 * @details Zero for points outside the stage.
+	 */
+	double getLowerBound(const PointF& p) const {
+		return getLowerBound(p.x, p.y);
+	}
+};
+
+#endif // DISTANCEFIELD_HPP
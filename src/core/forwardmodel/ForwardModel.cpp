@@ -0,0 +1,242 @@
+/**
+ * @file ForwardModel.cpp
+ * @author Tomáš Ludrovan
+ * @brief ForwardModel class
+ * @version 0.1
+ * @date 2024-05-17
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "core/forwardmodel/ForwardModel.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "functions.hpp"
+#include "core/Core.hpp"
+
+ForwardModel::ForwardModel(const Core& core)
+	: m_obstacles{core.m_stageObstacles}
+	, m_tickCount{0}
+	, m_pos(core.m_players.pos)
+	, m_hp(core.m_players.hp)
+	, m_size(core.m_players.size)
+	, m_speed(core.m_players.speed)
+	, m_strength(core.m_players.strength)
+	, m_isAlive(core.m_players.isAlive)
+	, m_alive(core.m_players.alive)
+	, m_bonusEffects(core.m_bonusEffects)
+{
+	for (const auto& [id, bonusData] : core.m_stageBonuses->getBonuses()) {
+		m_bonuses.push_back(Bonus{
+			id, // id
+			toCgalPoint(bonusData.position), // pos
+			bonusData.hpRecovery, // hpRecovery
+		});
+	}
+	// Same order regardless of the hash map
+	std::sort(m_bonuses.begin(), m_bonuses.end(),
+		[](const Bonus& lhs, const Bonus& rhs) { return lhs.id < rhs.id; });
+}
+
+void ForwardModel::updatePlayerAttributes(PlayerId id)
+{
+	double hp = m_hp[id];
+
+	m_size[id] = Core::getPlayerSize(hp);
+	m_speed[id] = Core::getPlayerSpeed(hp);
+	m_strength[id] = Core::getPlayerStrength(hp);
+}
+
+void ForwardModel::applyPlayerEffects()
+{
+	m_effectAttributes.assign(m_pos.size(), EffectAttributes());
+	m_bonusEffects.applyEffects(m_effectAttributes);
+}
+
+void ForwardModel::calculateTrajectories(
+	const std::vector<PlayerInputFlags>& inputs)
+{
+	double vx, vy;
+
+	for (PlayerId id : m_alive) {
+		Core::getPlayerMovementVector(inputs[id], m_speed[id], vx, vy);
+		m_trajectories[id] = m_obstacles->getPlayerTrajectory(m_pos[id],
+			Vector_2(vx, vy), m_size[id]);
+	}
+}
+
+void ForwardModel::findPlayerCollisions()
+{
+	for (PlayerId id : m_alive) {
+		m_playerCollisions[id].clear();
+	}
+
+	// The lookahead is done with a few players, so all the pairs are tested.
+	// The pairs are tested in the order of the IDs, so the collisions of each
+	// player are added in the order of the opponent IDs.
+	for (size_t i = 0; i < m_alive.size(); i++) {
+		PlayerId idA = m_alive[i];
+
+		for (size_t j = i + 1; j < m_alive.size(); j++) {
+			PlayerId idB = m_alive[j];
+
+			double minSqdist = m_trajectories[idA].minSqdist(
+				m_trajectories[idB]);
+			double playerSqsizes = sqr(m_size[idA] + m_size[idB]);
+
+			if (minSqdist <= playerSqsizes) {
+				m_playerCollisions[idA].push_back(PlayerCollision{
+					idB, // opponentId
+					m_strength[idB], // opponentStrength
+				});
+				m_playerCollisions[idB].push_back(PlayerCollision{
+					idA, // opponentId
+					m_strength[idA], // opponentStrength
+				});
+			}
+		}
+	}
+}
+
+void ForwardModel::findBonusCollisions()
+{
+	m_bonusPickups.clear();
+
+	for (PlayerId id : m_alive) {
+		double sqSizes = sqr(m_size[id] + BONUS_RADIUS);
+
+		for (size_t i = 0; i < m_bonuses.size(); i++) {
+			Trajectory bonusTraj(m_bonuses[i].pos);
+
+			if (m_trajectories[id].minSqdist(bonusTraj) <= sqSizes) {
+				m_bonusPickups.emplace_back(id, i);
+			}
+		}
+	}
+}
+
+void ForwardModel::updatePlayersStates(
+	const std::vector<PlayerInputFlags>& inputs)
+{
+	for (PlayerId id : m_alive) {
+		auto& hp = m_hp[id];
+
+		// Move
+		m_pos[id] = m_trajectories[id].end();
+
+		hp = Core::getNewPlayerHp(*m_obstacles, m_pos[id], hp,
+			m_playerCollisions[id],
+			m_effectAttributes[id].getAttributeChangeHp(), inputs[id].deflate);
+
+		if (hp <= 0.0) {
+			m_isAlive[id] = false;
+			m_bonusEffects.removePlayer(id);
+		} else {
+			updatePlayerAttributes(id);
+		}
+	}
+
+	// Bonus effects
+	for (const auto& [id, bonusIdx] : m_bonusPickups) {
+		if (m_isAlive[id]) {
+			m_bonusEffects.getHpPool().add(id,
+				m_bonuses[bonusIdx].hpRecovery);
+		}
+	}
+
+	// Remove the collected bonuses (the pickups are sorted by the player, not
+	// by the bonus)
+	for (const auto& [id, bonusIdx] : m_bonusPickups) {
+		(void)id;
+		m_bonuses[bonusIdx].id = BONUS_ID_NULL;
+	}
+	m_bonuses.erase(
+		std::remove_if(m_bonuses.begin(), m_bonuses.end(),
+			[](const Bonus& bonus) { return bonus.id == BONUS_ID_NULL; }),
+		m_bonuses.end()
+	);
+
+	// Remove the killed players
+	m_alive.erase(
+		std::remove_if(m_alive.begin(), m_alive.end(),
+			[this](PlayerId id) { return !m_isAlive[id]; }),
+		m_alive.end()
+	);
+}
+
+void ForwardModel::step(const std::vector<PlayerInputFlags>& inputs)
+{
+	assert(inputs.size() == m_pos.size());
+
+	m_trajectories.resize(m_pos.size());
+	m_playerCollisions.resize(m_pos.size());
+
+	applyPlayerEffects();
+	calculateTrajectories(inputs);
+	findPlayerCollisions();
+	findBonusCollisions();
+	updatePlayersStates(inputs);
+
+	m_tickCount++;
+}
+
+void ForwardModel::step(const std::vector<PlayerInputFlags>& inputs,
+	unsigned tickCount)
+{
+	for (unsigned i = 0; i < tickCount; i++) {
+		step(inputs);
+	}
+}
+
+uint64_t ForwardModel::getTickCount() const
+{
+	return m_tickCount;
+}
+
+bool ForwardModel::isOver() const
+{
+	return m_alive.size() < 2;
+}
+
+size_t ForwardModel::getPlayerCount() const
+{
+	return m_pos.size();
+}
+
+const std::vector<PlayerId>& ForwardModel::getAlivePlayers() const
+{
+	return m_alive;
+}
+
+bool ForwardModel::isPlayerAlive(PlayerId id) const
+{
+	return m_isAlive[id];
+}
+
+const Point_2& ForwardModel::getPlayerPos(PlayerId id) const
+{
+	return m_pos[id];
+}
+
+double ForwardModel::getPlayerHp(PlayerId id) const
+{
+	return m_hp[id];
+}
+
+double ForwardModel::getPlayerSize(PlayerId id) const
+{
+	return m_size[id];
+}
+
+double ForwardModel::getPlayerSpeed(PlayerId id) const
+{
+	return m_speed[id];
+}
+
+double ForwardModel::getPlayerStrength(PlayerId id) const
+{
+	return m_strength[id];
+}
@@ -0,0 +1,123 @@
+/**
+ * @file ForwardModel.hpp
+ * @author Tomáš Ludrovan
+ * @brief ForwardModel class
+ * @version 0.1
+ * @date 2024-05-17
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef FORWARDMODEL_HPP
+#define FORWARDMODEL_HPP
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/Common.hpp"
+#include "core/bonuseffect/BonusEffect.hpp"
+#include "core/geometry/Geometry.hpp"
+#include "core/stageobstacles/StageObstacles.hpp"
+#include "core/trajectory/Trajectory.hpp"
+#include "playerinput/PlayerInputFlags.hpp"
+
+class Core;
+
+/**
+ * @brief Simulation of the game which can be advanced with arbitrary inputs.
+ * 
+ * @details Intended for the lookahead of the AI agents. Follows the same rules
+ *          as `Core` (movement, collisions, bonus effects, deflating), except
+ *          that no new bonuses are generated, as those are random.
+ * 
+ *          Copying is cheap: the obstacles are shared, and the active bonus
+ *          effects are stored in packed arrays, which are copied at once.
+ */
+class ForwardModel {
+private:
+	struct Bonus {
+		BonusId id;
+		Point_2 pos;
+		BonusEffectHpPool::HpRecovery hpRecovery;
+	};
+
+	std::shared_ptr<const StageObstacles> m_obstacles;
+	uint64_t m_tickCount;
+
+	// Indexed by the player ID
+	std::vector<Point_2> m_pos;
+	std::vector<double> m_hp;
+	std::vector<double> m_size;
+	std::vector<double> m_speed;
+	std::vector<double> m_strength;
+	std::vector<bool> m_isAlive;
+	// IDs of the alive players in ascending order
+	std::vector<PlayerId> m_alive;
+
+	BonusEffectSystem m_bonusEffects;
+	std::vector<Bonus> m_bonuses;
+
+	// Scratch buffers of `step()`
+	// Indexed by the player ID
+	std::vector<Trajectory> m_trajectories;
+	// Indexed by the player ID
+	std::vector<EffectAttributes> m_effectAttributes;
+	// Indexed by the player ID; sorted by the opponent ID
+	std::vector<std::vector<PlayerCollision>> m_playerCollisions;
+	// Bonuses collected in the current tick (index to `m_bonuses`)
+	std::vector<std::pair<PlayerId, size_t>> m_bonusPickups;
+
+	void updatePlayerAttributes(PlayerId id);
+	void applyPlayerEffects();
+	void calculateTrajectories(const std::vector<PlayerInputFlags>& inputs);
+	void findPlayerCollisions();
+	void findBonusCollisions();
+	void updatePlayersStates(const std::vector<PlayerInputFlags>& inputs);
+public:
+	/**
+	 * @brief Constructs a model of the current state of `core`.
+	 */
+	ForwardModel(const Core& core);
+
+	/**
+	 * @brief Advances the simulation by one tick.
+	 * 
+	 * @param inputs Inputs of the players indexed by the player ID (dead
+	 *               players' inputs are ignored).
+	 */
+	void step(const std::vector<PlayerInputFlags>& inputs);
+	/**
+	 * @brief Advances the simulation by `tickCount` ticks with the same
+	 *        inputs.
+	 */
+	void step(const std::vector<PlayerInputFlags>& inputs, unsigned tickCount);
+
+	/**
+	 * @brief Returns the number of ticks simulated since the model was
+	 *        created.
+	 */
+	uint64_t getTickCount() const;
+	/**
+	 * @brief Checks whether less than two players are alive.
+	 */
+	bool isOver() const;
+	/**
+	 * @brief Returns the number of players (including the dead ones).
+	 */
+	size_t getPlayerCount() const;
+	/**
+	 * @brief Returns the IDs of the alive players in ascending order.
+	 */
+	const std::vector<PlayerId>& getAlivePlayers() const;
+	bool isPlayerAlive(PlayerId id) const;
+	const Point_2& getPlayerPos(PlayerId id) const;
+	double getPlayerHp(PlayerId id) const;
+	double getPlayerSize(PlayerId id) const;
+	double getPlayerSpeed(PlayerId id) const;
+	double getPlayerStrength(PlayerId id) const;
+};
+
+#endif // FORWARDMODEL_HPP
@@ -0,0 +1,192 @@
+/**
+ * @file test.cpp
+ * @author Tomáš Ludrovan
+ * @brief Test suite for the `ForwardModel` class.
+ * @version 0.1
+ * @date 2024-05-28
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * @details The forward model is stepped next to a `Core` replaying a recorded
+ *          match; the positions and HP of the players must be the same. The
+ *          comparison ends when the first bonus spawns, as the forward model
+ *          does not generate bonuses.
+ *
+ *          Must be run from the repository root (the stages are loaded from
+ *          the "stage/" directory).
+ */
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "aiplayeragent/AIPlayerAgentFactory.hpp"
+#include "core/Core.hpp"
+#include "core/forwardmodel/ForwardModel.hpp"
+#include "playerinput/PlayerInputFactory.hpp"
+#include "replay/ReplayReader.hpp"
+#include "stageserializer/StageSerializerFactory.hpp"
+
+// You might want to disable this if your terminal does not support
+// ANSI escape codes.
+#define ENABLE_COLORED_OUTPUT
+
+#ifdef ENABLE_COLORED_OUTPUT
+#	define BEGIN_FAILED_TEXT "\x1B[31m"  // Red
+#	define BEGIN_PASSED_TEXT "\x1B[32m"  // Green
+#	define RESET_TEXT "\x1B[0m"          // Default
+#else // !ENABLE_COLORED_OUTPUT
+#	define BEGIN_FAILED_TEXT
+#	define BEGIN_PASSED_TEXT
+#	define RESET_TEXT
+#endif // !ENABLE_COLORED_OUTPUT
+
+// Length of the recorded matches
+static constexpr unsigned MAX_TICKS = 3000;
+
+/**
+ * @brief Records a match of AI agents (predators and prey, so the players
+ *        collide a lot).
+ */
+static void recordMatch(const std::string& stageId, RNGSeedType seed,
+	size_t playerCount, const std::string& path)
+{
+	GameSetupData gsdata;
+	gsdata.stage = StageSerializerFactory::createDefault();
+	gsdata.stage->load(stageId);
+	gsdata.stageId = stageId;
+	gsdata.seed = seed;
+	gsdata.recordPath = path;
+
+	for (PlayerId id = 0; id < playerCount; id++) {
+		auto agent = (id % 2 == 0
+			? AIPlayerAgentFactory::createWallAwarePredatorAIPlayerAgent(id)
+			: AIPlayerAgentFactory::createWallAwarePreyAIPlayerAgent(id));
+		gsdata.players.push_back(PlayerInputFactory::createAIPlayerInput(
+			agent));
+		gsdata.aiAgents.push_back(agent);
+	}
+
+	Core core(gsdata);
+	core.step();
+	for (unsigned i = 0; i < MAX_TICKS && !core.isOver(); i++) {
+		core.step();
+	}
+	core.quit();
+}
+
+/**
+ * @brief Checks whether the forward model is in the same state as the core.
+ */
+static bool isSameState(const Core& core, const ForwardModel& model)
+{
+	auto states = core.getPlayerStates();
+	if (states.size() != model.getAlivePlayers().size()) return false;
+
+	for (PlayerId id : model.getAlivePlayers()) {
+		auto it = states.find(id);
+		if (it == states.end()) return false;
+
+		const auto& pos = model.getPlayerPos(id);
+		if (it->second.x != CGAL::to_double(pos.x())
+			|| it->second.y != CGAL::to_double(pos.y())
+			|| it->second.hp != model.getPlayerHp(id))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Replays the match and steps the forward model next to it.
+ *
+ * @param path The recorded match.
+ * @param tickCount Number of the compared ticks.
+ * @return True if the states are the same in all the compared ticks.
+ */
+static bool compareWithCore(const std::string& path, unsigned& tickCount)
+{
+	auto gsdata = ReplayReader::createGameSetup(
+		std::make_shared<ReplayReader>(path));
+	// The inputs for the forward model
+	ReplayReader reader(path);
+	std::vector<PlayerInputFlags> inputs;
+
+	Core core(gsdata);
+	core.step();
+	ForwardModel model(core);
+
+	bool res = true;
+	for (tickCount = 0; res && !core.isOver(); tickCount++) {
+		const auto& events = core.step();
+		if (!reader.readTick(inputs)) break;
+		model.step(inputs);
+
+		res = isSameState(core, model);
+
+		bool isBonusAdded = false;
+		for (const auto& e : events.getEvents()) {
+			isBonusAdded = isBonusAdded
+				|| (e.type == CoreEvent::EVENT_ADD_BONUS);
+		}
+		if (isBonusAdded) break;
+	}
+	core.quit();
+	return res;
+}
+
+/**
+ * @brief Test case setup.
+ *
+ * @details `testName` is a `const char*` value identifying the test case.
+ */
+#define BEGIN_TEST(testName) try { \
+	std::cout << testName << std::endl;
+
+/**
+ * @brief Test case verify and teardown.
+ *
+ * @details `isPassed` is a boolean rvalue which identifies the result of test
+ *          case.
+ */
+#define END_TEST(isPassed)                                         \
+	std::cout << ((isPassed)                                       \
+			? BEGIN_PASSED_TEXT "Passed" RESET_TEXT                \
+			: BEGIN_FAILED_TEXT "Failed" RESET_TEXT)               \
+		<< std::endl;                                              \
+	if (isPassed) ++passCount;                                     \
+	++testCount;                                                   \
+} catch (...) {                                                    \
+	std::cout << BEGIN_FAILED_TEXT "Failed (exception)" RESET_TEXT \
+		<< std::endl;                                              \
+	++testCount;                                                   \
+}
+
+#define TEST_CASE_MATCH(stageId, seed, playerCount)                       \
+	BEGIN_TEST(stageId " (seed " #seed ", " #playerCount " players)")      \
+		recordMatch(stageId, seed, playerCount, replayPath);                \
+		unsigned tickCount;                                                 \
+		bool isSame = compareWithCore(replayPath, tickCount);               \
+		std::cout << tickCount << " ticks compared" << std::endl;           \
+	END_TEST(isSame)
+
+
+int main()
+{
+	int passCount = 0, testCount = 0;
+	std::string replayPath = (std::filesystem::temp_directory_path()
+		/ "forwardmodel-test.rpl").string();
+
+	TEST_CASE_MATCH("too_many_players", 1, 32)
+	TEST_CASE_MATCH("too_many_players", 2, 64)
+	TEST_CASE_MATCH("crowd_arena", 2, 32)
+	TEST_CASE_MATCH("shattered_glass", 2, 32)
+	TEST_CASE_MATCH("wall", 5, 8)
+
+	std::filesystem::remove(replayPath);
+
+	std::cout << "Result: " << passCount << "/" << testCount << std::endl;
+	return (passCount == testCount ? 0 : 1);
+}
@@ -0,0 +1,74 @@
+/**
+ * @file SpawnGenerator.cpp
+ * @author Tomáš Ludrovan
+ * @brief SpawnGenerator class
+ * @version 0.1
+ * @date 2024-05-21
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "core/spawngenerator/SpawnGenerator.hpp"
+
+#include <algorithm>
+
+#include "math/Math.hpp"
+
+SpawnGenerator::SpawnGenerator(const DistanceField& distanceField,
+	const Size2d& stageSize, double playerRadius, RNGineType& rng)
+	: m_spacing{2.0*playerRadius + SPAWN_GAP}
+	, m_nextCandidate{0}
+{
+	// The grid is centered, so the margins at the stage bounds are even
+	int cols = static_cast<int>(stageSize.w / m_spacing);
+	int rows = static_cast<int>(stageSize.h / m_spacing);
+	double x0 = (stageSize.w - (cols - 1) * m_spacing) / 2.0;
+	double y0 = (stageSize.h - (rows - 1) * m_spacing) / 2.0;
+
+	for (int row = 0; row < rows; row++) {
+		for (int col = 0; col < cols; col++) {
+			Point_2 pos(x0 + col * m_spacing, y0 + row * m_spacing);
+			if (distanceField.getLowerBound(pos) >= playerRadius) {
+				m_candidates.push_back(pos);
+			}
+		}
+	}
+
+	std::shuffle(m_candidates.begin(), m_candidates.end(), rng);
+
+	if (m_candidates.empty()) {
+		// No free space -- all the players will be in the middle
+		m_candidates.push_back(Point_2(stageSize.w / 2.0, stageSize.h / 2.0));
+	}
+}
+
+bool SpawnGenerator::isReserved(const Point_2& pos) const
+{
+	for (const auto& reserved : m_reserved) {
+		if (CGAL::squared_distance(pos, reserved) < sqr(m_spacing)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void SpawnGenerator::reserve(const Point_2& pos)
+{
+	m_reserved.push_back(pos);
+}
+
+Point_2 SpawnGenerator::generate()
+{
+	while (m_nextCandidate < m_candidates.size()) {
+		const Point_2& pos = m_candidates[m_nextCandidate++];
+		if (!isReserved(pos)) {
+			return pos;
+		}
+	}
+
+	// Full -- start over
+	m_reserved.clear();
+	m_nextCandidate = 0;
+	return m_candidates[m_nextCandidate++];
+}
@@ -0,0 +1,73 @@
+/**
+ * @file SpawnGenerator.hpp
+ * @author Tomáš Ludrovan
+ * @brief SpawnGenerator class
+ * @version 0.1
+ * @date 2024-05-21
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef SPAWNGENERATOR_HPP
+#define SPAWNGENERATOR_HPP
+
+#include <vector>
+
+#include "functions.hpp"
+#include "types.hpp"
+#include "core/geometry/Geometry.hpp"
+#include "core/distancefield/DistanceField.hpp"
+
+/**
+ * @brief Generates spawn positions for the players the stage does not have
+ *        positions for.
+ * 
+ * @details The candidate positions form a grid over the free space of the
+ *          stage (according to the distance field, so the positions right next
+ *          to an obstacle may be left out). The grid step is the player
+ *          diameter (plus a small gap), so no two generated players overlap.
+ *          The candidates are taken in a random order.
+ */
+class SpawnGenerator {
+private:
+	// Gap between the neighboring spawned players
+	static constexpr double SPAWN_GAP = 1.0;
+
+	// Grid step
+	double m_spacing;
+	// Free positions in the order they are handed out
+	std::vector<Point_2> m_candidates;
+	size_t m_nextCandidate;
+	// Positions of the players placed by the stage
+	std::vector<Point_2> m_reserved;
+
+	/**
+	 * @brief Checks whether a candidate is too close to a reserved position.
+	 */
+	bool isReserved(const Point_2& pos) const;
+public:
+	/**
+	 * @brief Constructs a new SpawnGenerator object.
+	 * 
+	 * @param distanceField Distance field of the stage.
+	 * @param stageSize
+	 * @param playerRadius Radius (size) of a spawned player.
+	 * @param rng Random number engine used for ordering the candidates.
+	 */
+	SpawnGenerator(const DistanceField& distanceField,
+		const Size2d& stageSize, double playerRadius, RNGineType& rng);
+	/**
+	 * @brief Marks a position as taken by a player placed by the stage.
+	 */
+	void reserve(const Point_2& pos);
+	/**
+	 * @brief Returns the next spawn position.
+	 * 
+	 * @details If the stage is full, the positions are handed out again (the
+	 *          players overlap then).
+	 */
+	Point_2 generate();
+};
+
+#endif // SPAWNGENERATOR_HPP
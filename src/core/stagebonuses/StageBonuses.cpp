@@ -15,16 +15,15 @@
 
 #include <ostream>
 
-BonusId StageBonuses::generateBonusId() const
+BonusId StageBonuses::generateBonusId()
 {
-	static BonusId lastBonusId = 0;
-	return ++lastBonusId;
+	return ++m_lastBonusId;
 }
 
-void StageBonuses::initGridOffsets()
+void StageBonuses::initGridOffsets(RNGineType& rng)
 {
-	m_gridOffsetX = generateGridOffset();
-	m_gridOffsetY = generateGridOffset();
+	m_gridOffsetX = generateGridOffset(rng);
+	m_gridOffsetY = generateGridOffset(rng);
 }
 
 void StageBonuses::initBonusGrid(const Size2d& stageSize)
@@ -40,13 +39,14 @@ void StageBonuses::initBonusGrid(const Size2d& stageSize)
 		for (pt.x = stageBounds.x; pt.x <= stageBounds.getRight();
 			pt.x += BONUS_GRID_CELL_SIZE) // For each column
 		{
-			m_validPositions.insert(pt);
+			m_validPositions->insert(pt);
 		}
 	}
 }
 
 void StageBonuses::invalidatePositionsByObstacles(
-	const std::vector<StageObstacle>& obstacles)
+	const std::vector<StageObstacle>& obstacles,
+	const DistanceField& distanceField)
 {
 	// The idea is for each obstacle to find the smallest rectangle in which
 	// a collision with bonus may happen, and then for each "valid" position
@@ -70,10 +70,14 @@ void StageBonuses::invalidatePositionsByObstacles(
 			for (pt.x = bbox.x; pt.x <= bbox.getRight();
 				pt.x += BONUS_GRID_CELL_SIZE) // For each column
 			{
+				if (distanceField.getLowerBound(pt) >= BONUS_RADIUS) {
+					// Far from all the obstacles
+					continue;
+				}
 				if (obstacle.sqrDistance(pt) < sqr(BONUS_RADIUS)) {
 					// Causes collision => not valid
 
-					m_validPositions.erase(pt);
+					m_validPositions->erase(pt);
 				}
 			}
 		}
@@ -81,11 +85,13 @@ void StageBonuses::invalidatePositionsByObstacles(
 }
 
 void StageBonuses::initValidPositions(
-	const std::vector<StageObstacle>& obstacles, const Size2d& stageSize)
+	const std::vector<StageObstacle>& obstacles,
+	const DistanceField& distanceField, const Size2d& stageSize,
+	RNGineType& rng)
 {
-	initGridOffsets();
+	initGridOffsets(rng);
 	initBonusGrid(stageSize);
-	invalidatePositionsByObstacles(obstacles);
+	invalidatePositionsByObstacles(obstacles, distanceField);
 }
 
 #ifdef ENABLE_BONUS_CONSTRAINTS
@@ -132,7 +138,7 @@ void StageBonuses::invalidateCircle(const PointF& center, double radius,
 		brushPt = borderPt;
 		while (brushPt.x >= center.x) { // Right of or at the "vertical central
 		                                // secant"
-			m_validPositions.erase(brushPt);
+			m_validPositions->erase(brushPt);
 			invalidatedOut.insert(brushPt);
 			brushPt.x -= BONUS_GRID_CELL_SIZE; // Move left
 		}
@@ -158,7 +164,7 @@ void StageBonuses::invalidateCircle(const PointF& center, double radius,
 		// Paint
 		brushPt = borderPt;
 		while (brushPt.x < center.x) { // Left of the "vertical central secant"
-			m_validPositions.erase(brushPt);
+			m_validPositions->erase(brushPt);
 			invalidatedOut.insert(brushPt);
 			brushPt.x += BONUS_GRID_CELL_SIZE; // Move right
 		}
@@ -185,7 +191,7 @@ void StageBonuses::invalidateCircle(const PointF& center, double radius,
 		// Paint
 		brushPt = borderPt;
 		while (brushPt.x < center.x) { // Left of the "vertical central secant"
-			m_validPositions.erase(brushPt);
+			m_validPositions->erase(brushPt);
 			invalidatedOut.insert(brushPt);
 			brushPt.x += BONUS_GRID_CELL_SIZE; // Move right
 		}
@@ -213,7 +219,7 @@ void StageBonuses::invalidateCircle(const PointF& center, double radius,
 		brushPt = borderPt;
 		while (brushPt.x >= center.x) { // Right of or at the "vertical central
 		                                // secant"
-			m_validPositions.erase(brushPt);
+			m_validPositions->erase(brushPt);
 			invalidatedOut.insert(brushPt);
 			brushPt.x -= BONUS_GRID_CELL_SIZE; // Move left
 		}
@@ -263,7 +269,7 @@ PointF StageBonuses::snapPoint(const PointF& pt) const
 	return res;
 }
 
-double StageBonuses::generateGridOffset()
+double StageBonuses::generateGridOffset(RNGineType& rng)
 {
 	// The number of binary digits in the fractional part of the generated
 	// number. The value should not be too high in order to represent big
@@ -276,34 +282,39 @@ double StageBonuses::generateGridOffset()
 	static constexpr int VALUE_COUNT =
 		static_cast<int>(BONUS_GRID_CELL_SIZE) * FRACTION_COUNT;
 
-	int r = rand() % VALUE_COUNT;
+	std::uniform_int_distribution<int> distrib(0, VALUE_COUNT - 1);
+	int r = distrib(rng);
 	double res = static_cast<double>(r) / static_cast<double>(FRACTION_COUNT);
 	return res;
 }
 
-BonusEffectHp::HpRecovery StageBonuses::generateHpRecovery()
+BonusEffectHpPool::HpRecovery StageBonuses::generateHpRecovery(
+	RNGineType& rng)
 {
 	//  x   | 0.25 | 0.50 | 0.75 | 1.00
 	// p(x) | 2/8  | 3/8  | 2/8  | 1/8
 	// F(x) | 2/8  | 5/8  | 7/8  | 8/8
 
-	static std::uniform_int_distribution<int> distrib(0, 7);
-	int Fx = distrib(getRNGine());
+	std::uniform_int_distribution<int> distrib(0, 7);
+	int Fx = distrib(rng);
 
 	if (Fx < 2)
-		return BonusEffectHp::RECOVER_25;
+		return BonusEffectHpPool::RECOVER_25;
 	else if (Fx < 5)
-		return BonusEffectHp::RECOVER_50;
+		return BonusEffectHpPool::RECOVER_50;
 	else if (Fx < 7)
-		return BonusEffectHp::RECOVER_75;
+		return BonusEffectHpPool::RECOVER_75;
 	else
-		return BonusEffectHp::RECOVER_100;
+		return BonusEffectHpPool::RECOVER_100;
 }
 
 StageBonuses::StageBonuses(const std::vector<StageObstacle>& obstacles,
-	const Size2d& stageSize)
+	const DistanceField& distanceField, const Size2d& stageSize,
+	RNGineType& rng)
+	: m_lastBonusId{BONUS_ID_NULL}
+	, m_validPositions{std::make_shared<PointFSet>()}
 {
-	initValidPositions(obstacles, stageSize);
+	initValidPositions(obstacles, distanceField, stageSize, rng);
 }
 
 #ifdef ENABLE_BONUS_CONSTRAINTS
@@ -313,7 +324,7 @@ void StageBonuses::reportPlayerStates(const std::vector<PlayerState>& states)
 		if (m_bonusInvalidPositions.find(pt)
 			== m_bonusInvalidPositions.cend())
 		{
-			m_validPositions.insert(pt);
+			m_validPositions->insert(pt);
 		}
 	}
 	m_playerInvalidPositions.clear();
@@ -326,9 +337,9 @@ void StageBonuses::reportPlayerStates(const std::vector<PlayerState>& states)
 }
 #endif // ENABLE_BONUS_CONSTRAINTS
 
-BonusId StageBonuses::generateBonus()
+BonusId StageBonuses::generateBonus(RNGineType& rng)
 {
-	if (m_validPositions.size() == 0) {
+	if (m_validPositions->size() == 0) {
 		// No valid positions => cannot generate bonus
 
 		return BONUS_ID_NULL;
@@ -338,12 +349,12 @@ BonusId StageBonuses::generateBonus()
 
 		// Choose position
 		std::uniform_int_distribution<size_t> distrib(0,
-			m_validPositions.size() - 1);
-		size_t posIdx = distrib(getRNGine());
-		PointF position = m_validPositions.atIndex(static_cast<size_t>(posIdx));
+			m_validPositions->size() - 1);
+		size_t posIdx = distrib(rng);
+		PointF position = m_validPositions->atIndex(static_cast<size_t>(posIdx));
 
 		// Choose HP recovery
-		auto hpRecovery = generateHpRecovery();
+		auto hpRecovery = generateHpRecovery(rng);
 		
 		// Create
 		m_bonuses[id] = BonusData(position, hpRecovery);
@@ -356,20 +367,33 @@ BonusId StageBonuses::generateBonus()
 	}
 }
 
+void StageBonuses::saveState(State& out) const
+{
+	out.bonuses.assign(m_bonuses.begin(), m_bonuses.end());
+	out.lastBonusId = m_lastBonusId;
+}
+
+void StageBonuses::restoreState(const State& state)
+{
+	m_bonuses.clear();
+	m_bonuses.insert(state.bonuses.begin(), state.bonuses.end());
+	m_lastBonusId = state.lastBonusId;
+}
+
 void StageBonuses::clearBonus(BonusId id)
 {
 	m_bonuses.erase(id);
 }
 
-std::shared_ptr<BonusEffect> StageBonuses::getBonusEffect(BonusId id) const
+void StageBonuses::addBonusEffect(BonusId id, PlayerId playerId,
+	BonusEffectSystem& effects) const
 {
-	auto res = std::make_shared<BonusEffectHp>(m_bonuses.at(id).hpRecovery);
-	return res;
+	effects.getHpPool().add(playerId, m_bonuses.at(id).hpRecovery);
 }
 
 double StageBonuses::getBonusHpRecovery(BonusId id) const
 {
-	return BonusEffectHp::hpRecoveryToValue(m_bonuses.at(id).hpRecovery);
+	return BonusEffectHpPool::hpRecoveryToValue(m_bonuses.at(id).hpRecovery);
 }
 
 bool StageBonuses::canGenerateBonus() const
@@ -24,25 +24,38 @@
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "types.hpp"
+#include "functions.hpp"
 #include "core/Common.hpp"
 #include "core/playerstate/PlayerState.hpp"
 #include "core/bonuseffect/BonusEffect.hpp"
+#include "core/distancefield/DistanceField.hpp"
 #include "utilities/unorderedSetWithIndexes/UnorderedSetWithIndexes.hpp"
 
 class StageBonuses {
 public:
 	struct BonusData {
 		PointF position;
-		BonusEffectHp::HpRecovery hpRecovery;
+		BonusEffectHpPool::HpRecovery hpRecovery;
 
-		BonusData(const PointF& position_, BonusEffectHp::HpRecovery hpRecovery_)
+		BonusData(const PointF& position_, BonusEffectHpPool::HpRecovery hpRecovery_)
 			: position{position_}
 			, hpRecovery{hpRecovery_}
 		{}
-		BonusData() : BonusData(PointF(), BonusEffectHp::RECOVER_50) {}
+		BonusData() : BonusData(PointF(), BonusEffectHpPool::RECOVER_50) {}
+	};
+	/**
+	 * @brief The mutable part of the object.
+	 * 
+	 * @details The valid positions depend only on the stage, so they are not
+	 *          part of the state.
+	 */
+	struct State {
+		std::vector<std::pair<BonusId, BonusData>> bonuses;
+		BonusId lastBonusId;
 	};
 private:
 	typedef UnorderedSetWithIndexes<PointF, PointF::Hash> PointFSet;
@@ -55,6 +68,7 @@ private:
 	// Spacing between valid bonus positions
 	static constexpr double BONUS_GRID_CELL_SIZE = 5.0;
 
+	BonusId m_lastBonusId;
 	double m_gridOffsetX;
 	double m_gridOffsetY;
 	std::unordered_map<BonusId, BonusData> m_bonuses;
@@ -66,8 +80,9 @@ private:
 	//    `m_vP <- union(m_vP, S - Sc): Sc = complement(S, union(m_pIP, mbIP))`
 	//    `S <- {}`
 
-	// Positions where bonuses may be placed
-	PointFSet m_validPositions;
+	// Positions where bonuses may be placed. Computed once and shared by the
+	// copies of the object.
+	std::shared_ptr<PointFSet> m_validPositions;
 #ifdef ENABLE_BONUS_CONSTRAINTS
 	// Positions invalidated by players
 	PointFSet m_playerInvalidPositions;
@@ -78,7 +93,7 @@ private:
 	/**
 	 * @brief Initializes the `m_gridOffsetX/Y` variables.
 	 */
-	void initGridOffsets();
+	void initGridOffsets(RNGineType& rng);
 	/**
 	 * @brief Initializes the valid positions as a grid of points.
 	 */
@@ -88,17 +103,22 @@ private:
 	 *        blocked by obstacles.
 	 * 
 	 * @param obstacles Obstacles on the stage.
+	 * @param distanceField Distance field of the obstacles.
 	 */
 	void invalidatePositionsByObstacles(
-		const std::vector<StageObstacle>& obstacles);
+		const std::vector<StageObstacle>& obstacles,
+		const DistanceField& distanceField);
 	/**
 	 * @brief Initializes the list of valid bonus positions.
 	 * 
 	 * @param obstacles Obstacles on the stage.
+	 * @param distanceField Distance field of the obstacles.
 	 * @param stageSize
+	 * @param rng
 	 */
 	void initValidPositions(const std::vector<StageObstacle>& obstacles,
-		const Size2d& stageSize);
+		const DistanceField& distanceField, const Size2d& stageSize,
+		RNGineType& rng);
 #ifdef ENABLE_BONUS_CONSTRAINTS
 	/**
 	 * @brief Invalidates points within a circular area and inserts them to
@@ -133,7 +153,7 @@ private:
 	/**
 	 * @brief Generates a unique bonus ID.
 	 */
-	BonusId generateBonusId() const;
+	BonusId generateBonusId();
 	/**
 	 * @brief Generates a value for the `m_gridOffsetX/Y` variables.
 	 * 
@@ -141,20 +161,24 @@ private:
 	 *          part having only a few digits to allow representing big numbers
 	 *          precisely.
 	 */
-	static double generateGridOffset();
+	static double generateGridOffset(RNGineType& rng);
 	/**
 	 * @brief Chooses random HP recovery amount for a bonus.
 	 */
-	static BonusEffectHp::HpRecovery generateHpRecovery();
+	static BonusEffectHpPool::HpRecovery generateHpRecovery(RNGineType& rng);
 public:
 	/**
 	 * @brief Constructs a new StageBonuses object.
 	 * 
 	 * @param obstacles Obstacles on the stage.
+	 * @param distanceField Distance field of the obstacles (only used by the
+	 *                      constructor).
 	 * @param stageSize
+	 * @param rng Random number engine used for placing the bonus grid.
 	 */
 	StageBonuses(const std::vector<StageObstacle>& obstacles,
-		const Size2d& stageSize);
+		const DistanceField& distanceField, const Size2d& stageSize,
+		RNGineType& rng);
 
 #ifdef ENABLE_BONUS_CONSTRAINTS
 	/**
@@ -172,7 +196,17 @@ public:
 	 * @note (#ifdef ENABLE_BONUS_CONSTRAINTS) Call `reportPlayerStates()` right
 	 *       before calling this function.
 	 */
-	BonusId generateBonus();
+	BonusId generateBonus(RNGineType& rng);
+	/**
+	 * @brief Stores the current state to `out`.
+	 * 
+	 * @details The buffers of `out` are reused.
+	 */
+	void saveState(State& out) const;
+	/**
+	 * @brief Sets the current state to `state`.
+	 */
+	void restoreState(const State& state);
 	/**
 	 * @brief Removes a bonus.
 	 * 
@@ -180,9 +214,14 @@ public:
 	 */
 	void clearBonus(BonusId id);
 	/**
-	 * @brief Creates effect which is caused by picking up a bonus.
+	 * @brief Adds the effect which is caused by picking up a bonus.
+	 * 
+	 * @param id ID of the bonus.
+	 * @param playerId ID of the player who picked up the bonus.
+	 * @param effects Effects the new one is added to.
 	 */
-	std::shared_ptr<BonusEffect> getBonusEffect(BonusId id) const;
+	void addBonusEffect(BonusId id, PlayerId playerId,
+		BonusEffectSystem& effects) const;
 	/**
 	 * @brief Returns the amount of HP a bonus will recover in total.
 	 */
@@ -13,8 +13,12 @@
 
 #ifndef OLD_TRAJECTORY_ALGORITHM
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
+#include "math/Math.hpp"
+
 /**
  * @brief Checks if player has collision with a collision object.
  * 
@@ -24,18 +28,6 @@
  */
 static bool hasCollision(const Triangle_2& collObj, const Segment_2& seg,
 	double playerRadius);
-/**
- * @brief Finds the nearest collision object which a player has collision with.
- * 
- * @param collObjs Collision objects to check collision with.
- * @param seg Current trajectory shape.
- * @param playerRadius Radius (size) of the player bubble.
- * @param coll Found collsion (if any).
- * @return `false` if no collisions were found, `true` if at least one collision
- *         was found.
- */
-static bool findNearestCollision(const std::vector<Triangle_2>& collObjs,
-	const Segment_2& seg, double playerRadius, Triangle_2& coll);
 
 
 void StageObstacles::initializeCollisionObjects(
@@ -45,6 +37,7 @@ void StageObstacles::initializeCollisionObjects(
 		addObstacleToCollisionObjects(obstacle);
 	}
 	addBoundsToCollisionObjects(bounds);
+	initializeCollisionObjectsTree();
 }
 
 void StageObstacles::addObstacleToCollisionObjects(
@@ -88,99 +81,227 @@ void StageObstacles::addBoundsToCollisionObjects(const Size2d& bounds)
 	}
 }
 
+void StageObstacles::initializeCollisionObjectsTree()
+{
+	std::vector<CGAL::Bbox_2> bboxes;
+	bboxes.reserve(m_collObjs.size());
+	for (const auto& collObj : m_collObjs) {
+		bboxes.push_back(collObj.bbox());
+	}
+
+	m_collObjsTree = AABBTree(bboxes);
+}
+
 StageObstacles::StageObstacles(
 	const std::vector<StageObstacle>& obstacles, const Size2d& bounds)
+	: m_distanceField(obstacles, bounds)
 {
 	initializeCollisionObjects(obstacles, bounds);
 }
 
+const DistanceField& StageObstacles::getDistanceField() const
+{
+	return m_distanceField;
+}
+
 bool hasCollision(const Triangle_2& collObj, const Segment_2& seg,
 	double playerRadius)
 {
 	return (CGAL::squared_distance(collObj, seg) < CGAL::square(playerRadius));
 }
 
-bool findNearestCollision(const std::vector<Triangle_2>& collObjs,
-	const Segment_2& seg, double playerRadius, Triangle_2& coll)
+CGAL::Bbox_2 StageObstacles::getSweptBbox(const Segment_2& seg,
+	double playerRadius)
 {
-	// Squared distance from the nearest collision object with which the player
-	// collides
-	double currNearestSq = std::numeric_limits<double>::infinity();
-	double sqdist;
-	// Pointer to the nearest collision object with which the player collides.
-	// If `nullptr`, there was no collision (yet).
-	const Triangle_2* collPtr = nullptr;
-
-	for (const auto& collObj : collObjs) {
-		if (hasCollision(collObj, seg, playerRadius)) {
-			sqdist = CGAL::squared_distance(collObj, seg.source());
-			if (sqdist < currNearestSq) {
-				// Found the new nearest
-
-				currNearestSq = sqdist;
-				collPtr = &collObj;
+	CGAL::Bbox_2 segBbox = seg.bbox();
+	return CGAL::Bbox_2(
+		segBbox.xmin() - playerRadius,
+		segBbox.ymin() - playerRadius,
+		segBbox.xmax() + playerRadius,
+		segBbox.ymax() + playerRadius
+	);
+}
+
+bool StageObstacles::getTimeOfImpact(const Triangle_2& collObj,
+	const Point_2& playerPos, const Vector_2& playerMove, double playerRadius,
+	double& toi, Vector_2& normal)
+{
+	const double sqRadius = sqr(playerRadius);
+	const double sqMoveLen = playerMove.squared_length();
+
+	if (CGAL::squared_distance(collObj, playerPos) < sqRadius) {
+		// Already colliding
+
+		toi = 0.0;
+		normal = Vector_2(0.0, 0.0);
+		return true;
+	}
+
+	if (sqMoveLen == 0.0) {
+		// Not moving
+		
+		return false;
+	}
+
+	// Now the player is outside of all the edge capsules, so the path must
+	// enter one of them first
+
+	double res = std::numeric_limits<double>::infinity();
+	Vector_2 resNormal(0.0, 0.0);
+
+	for (int i = 0; i < 3; i++) {
+		const Point_2 a = collObj.vertex(i);
+		const Point_2 b = collObj.vertex(i + 1);
+		const Vector_2 edge = b - a;
+		const Vector_2 ap = playerPos - a;
+
+		// Edge (the side of the capsule). Distance of the player from the edge
+		// line is `dist(t) = dist0 + t*approach`.
+		Vector_2 n = edge.perpendicular(CGAL::COUNTERCLOCKWISE)
+			/ std::sqrt(edge.squared_length());
+		double dist0 = n * ap;
+		if (dist0 < 0.0) {
+			// Make the normal point to the player
+			n = -n;
+			dist0 = -dist0;
+		}
+		double approach = n * playerMove;
+		if (dist0 >= playerRadius && approach < 0.0) {
+			double t = (playerRadius - dist0) / approach;
+			// Projection of the contact point onto the edge
+			double u = ((ap + playerMove * t) * edge) / edge.squared_length();
+			if (u >= 0.0 && u <= 1.0 && t < res) {
+				res = t;
+				resNormal = n;
 			}
 		}
-	}
 
-	// Check if there was any collision...
-	if (collPtr != nullptr) {
-		// ... and return the collision object if so
+		// Vertex (the end cap of the capsule). Solve
+		// `|ap + t*playerMove|^2 = r^2`.
+		double qb = 2.0 * (ap * playerMove);
+		double qc = ap.squared_length() - sqRadius;
+		if (qb < 0.0) {
+			// Moving towards the vertex
+
+			double disc = sqr(qb) - 4.0 * sqMoveLen * qc;
+			if (disc >= 0.0) {
+				double t = (-qb - std::sqrt(disc)) / (2.0 * sqMoveLen);
+				if (t < res) {
+					res = t;
+					// From the vertex to the player center at the contact
+					resNormal = (ap + playerMove * t) / playerRadius;
+				}
+			}
+		}
+	}
 
-		coll = *collPtr;
+	if (res <= 1.0) {
+		toi = std::max(res, 0.0);
+		normal = resNormal;
+		return true;
+	} else {
+		return false;
 	}
+}
+
+bool StageObstacles::findFirstContact(const Point_2& playerPos,
+	const Vector_2& playerMove, double playerRadius, double& toi,
+	Vector_2& normal) const
+{
+	toi = std::numeric_limits<double>::infinity();
+	m_collObjsTree.query(
+		getSweptBbox(Segment_2(playerPos, playerPos + playerMove),
+			playerRadius),
+		[&](size_t idx) {
+			double objToi;
+			Vector_2 objNormal;
+			if (getTimeOfImpact(m_collObjs[idx], playerPos, playerMove,
+				playerRadius, objToi, objNormal) && objToi < toi)
+			{
+				toi = objToi;
+				normal = objNormal;
+			}
+			return true;
+		}
+	);
+
+	return (toi <= 1.0);
+}
 
-	return (collPtr != nullptr);
+bool StageObstacles::hasAnyCollision(const Segment_2& seg,
+	double playerRadius) const
+{
+	// The query is stopped by the first collision
+	return !m_collObjsTree.query(getSweptBbox(seg, playerRadius),
+		[&](size_t idx) {
+			return !hasCollision(m_collObjs[idx], seg, playerRadius);
+		}
+	);
 }
 
 Trajectory StageObstacles::getPlayerTrajectory(const Point_2& playerPos,
 	const Vector_2& playerMove, double playerRadius) const
 {
-	// Square of the maximum error of the bisection method
-	static constexpr double SQR_MAX_ERROR = sqr(0.5);
+	// Distance the player keeps from the obstacle after a contact
+	static constexpr double CONTACT_GAP = 1e-6;
 
 	// Source (starting point)
 	Point_2 sp(playerPos);
 	// Target (end point)
 	Point_2 ep(playerPos + playerMove);
-	Triangle_2 collObj;
 
-	if (findNearestCollision(m_collObjs, Segment_2(sp, ep), playerRadius, collObj)) {
-		Vector_2 bumpVect = playerMove;
-		
-		// Approximate collision point using bisection method
-		while (bumpVect.squared_length() > SQR_MAX_ERROR) {
-			// Bisect
-			bumpVect /= 2;
-
-			if (hasCollision(collObj, Segment_2(sp, ep), playerRadius)) {
-				// Inside collision object -- go back
-
-				ep -= bumpVect;
-			} else {
-				// Outside collision object -- go forward
+	// Every point of the path is at most `moveLen` away from the source, so
+	// if the obstacles are far enough, none of them can be hit
+	double moveLen = std::sqrt(playerMove.squared_length());
+	if (m_distanceField.getLowerBound(sp) > moveLen + playerRadius) {
+		Trajectory res(Segment_2(sp, ep));
+		return res;
+	}
 
-				ep += bumpVect;
-			}
+	Point_2 pos(sp);
+	Vector_2 move(playerMove);
+	// Position to return to if pushing off the obstacle ends up in another
+	// one (in a corner)
+	Point_2 safePos(sp);
+	// Whether `pos` is a push-off position which has not been checked yet
+	bool isPushedOff = false;
+	for (int i = 0; i < MAX_SLIDE_ITERATIONS; i++) {
+		double toi;
+		Vector_2 n;
+		if (!findFirstContact(pos, move, playerRadius, toi, n)) {
+			// Free path
+			pos = pos + move;
+			isPushedOff = false;
+			break;
 		}
-
-		if (hasCollision(collObj, Segment_2(sp, ep), playerRadius)) {
-			// Approximation ended up inside the collision object -- undo the
-			// last "bump"
-
-			ep -= bumpVect;
-
-			// Positive side is in the direction of the player movement
-			Line_2 l(playerPos, playerMove.perpendicular(
-				CGAL::CLOCKWISE));
-			if (!l.has_on_positive_side(ep)) {
-				// Player is moving in opposite direction -- fix that!
-
-				ep = playerPos;
-				// Now the player is not moving at all
-			}
+		if (n == Vector_2(0.0, 0.0)) {
+			// Already colliding -- the player cannot move
+			pos = safePos;
+			isPushedOff = false;
+			break;
 		}
+
+		// Stop before the contact along the movement
+		double t = std::max(toi
+			- CONTACT_GAP / std::sqrt(move.squared_length()), 0.0);
+		safePos = (t > 0.0) ? pos + move * t : pos;
+
+		// Move to the contact and push off the obstacle a bit, so the player
+		// does not collide even after rounding errors
+		pos = pos + move * toi + n * CONTACT_GAP;
+		isPushedOff = true;
+
+		// Slide -- only the part of the rest of the movement that is not
+		// heading into the obstacle remains
+		Vector_2 remaining = move * (1.0 - toi);
+		move = remaining - n * std::min(remaining * n, 0.0);
+		if (move.squared_length() < sqr(CONTACT_GAP)) break;
+	}
+	if (isPushedOff && playerHasCollision(pos, playerRadius)) {
+		// The loop ended right after pushing off into another obstacle
+		pos = safePos;
 	}
+	ep = pos;
 
 	Trajectory res(Segment_2(sp, ep));
 	return res;
@@ -189,9 +310,12 @@ Trajectory StageObstacles::getPlayerTrajectory(const Point_2& playerPos,
 bool StageObstacles::playerHasCollision(const Point_2& playerPos,
 	double playerRadius) const
 {
-	Triangle_2 devnull;
-	return findNearestCollision(m_collObjs, Segment_2(playerPos, playerPos),
-		playerRadius, devnull);
+	if (m_distanceField.getLowerBound(playerPos) >= playerRadius) {
+		// Far from the obstacles
+		return false;
+	}
+
+	return hasAnyCollision(Segment_2(playerPos, playerPos), playerRadius);
 }
 
 #else // OLD_TRAJECTORY_ALGORITHM
@@ -616,6 +740,7 @@ StageObstacles::StageObstacles(
 	const std::vector<StageObstacle>& obstacles, const Size2d& bounds)
 	: m_obstacles{obstacles}
 	, m_bounds{bounds}
+	, m_distanceField(obstacles, bounds)
 {
 	initializeCollisionObjects(obstacles, bounds);
 }
@@ -630,6 +755,11 @@ const Size2d& StageObstacles::getStageSize() const
 	return m_bounds;
 }
 
+const DistanceField& StageObstacles::getDistanceField() const
+{
+	return m_distanceField;
+}
+
 Trajectory StageObstacles::getPlayerTrajectory(const Point_2& playerPos,
 	const Vector_2& playerMove, double playerRadius)
 {
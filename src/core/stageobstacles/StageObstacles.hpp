@@ -17,6 +17,8 @@
 
 #include "types.hpp"
 #include "core/Common.hpp"
+#include "core/aabbtree/AABBTree.hpp"
+#include "core/distancefield/DistanceField.hpp"
 #include "core/geometry/Geometry.hpp"
 #include "core/trajectory/Trajectory.hpp"
 #include "playerinput/IPlayerInput.hpp"
@@ -44,6 +46,8 @@ private:
 	std::vector<Wall> m_walls;
 	std::vector<Corner> m_corners;
 
+	DistanceField m_distanceField;
+
 	/**
 	 * @brief Initializes the wall and corner data.
 	 * 
@@ -117,6 +121,10 @@ public:
 		const Size2d& bounds);
 	const std::vector<StageObstacle>& getObstaclesList() const;
 	const Size2d& getStageSize() const;
+	/**
+	 * @brief Returns the distance field of the obstacles and the stage bounds.
+	 */
+	const DistanceField& getDistanceField() const;
 	/**
 	 * @brief Creates the player trajectory, taking the obstacles into account.
 	 */
@@ -126,8 +134,16 @@ public:
 #else // OLD_TRAJECTORY_ALGORITHM
 class StageObstacles {
 private:
+	// Maximum number of times a player may slide along an obstacle during one
+	// movement
+	static constexpr int MAX_SLIDE_ITERATIONS = 3;
+
 	// Collision objects
 	std::vector<Triangle_2> m_collObjs;
+	// Bounding volume hierarchy over `m_collObjs`
+	AABBTree m_collObjsTree;
+	// Lower bounds of the distance from `m_collObjs`
+	DistanceField m_distanceField;
 
 	/**
 	 * @brief Initializes the collision objects data.
@@ -146,11 +162,81 @@ private:
 	 * @brief Adds the stage walls to the collision objects list.
 	 */
 	void addBoundsToCollisionObjects(const Size2d& bounds);
+	/**
+	 * @brief Builds the bounding volume hierarchy over the collision objects.
+	 */
+	void initializeCollisionObjectsTree();
+
+	/**
+	 * @brief Returns the bounding box of the capsule swept by a player.
+	 * 
+	 * @param seg Current trajectory shape.
+	 * @param playerRadius Radius (size) of the player bubble.
+	 */
+	static CGAL::Bbox_2 getSweptBbox(const Segment_2& seg, double playerRadius);
+	/**
+	 * @brief Calculates the time of impact of a moving player and
+	 *        a collision object.
+	 * 
+	 * @details The player moves along `playerPos + t*playerMove` for `t` in
+	 *          [0, 1]. The time of impact is the lowest `t` at which the
+	 *          distance of the player (center) and the collision object is
+	 *          equal to the player radius. It is calculated in closed form as
+	 *          the first intersection of the player path with the edges of the
+	 *          collision object moved outwards by the radius, and with the
+	 *          circles around the collision object's vertexes.
+	 * 
+	 * @param collObj The collision object.
+	 * @param playerPos Initial position of the player.
+	 * @param playerMove Player movement vector.
+	 * @param playerRadius Radius (size) of the player bubble.
+	 * @param toi The time of impact (if any). Zero if the player already
+	 *            collides with the object at `playerPos`.
+	 * @param normal Unit normal of the contact, pointing towards the player
+	 *               (if any). Zero vector if the player already collides with
+	 *               the object at `playerPos`.
+	 * @return `true` if the player hits the collision object within the
+	 *         movement, `false` otherwise.
+	 */
+	static bool getTimeOfImpact(const Triangle_2& collObj,
+		const Point_2& playerPos, const Vector_2& playerMove,
+		double playerRadius, double& toi, Vector_2& normal);
+	/**
+	 * @brief Finds the earliest contact of a moving player with any
+	 *        collision object.
+	 * 
+	 * @param playerPos Initial position of the player.
+	 * @param playerMove Player movement vector.
+	 * @param playerRadius Radius (size) of the player bubble.
+	 * @param toi The time of impact (if any).
+	 * @param normal Unit normal of the contact (see `getTimeOfImpact()`).
+	 * @return `true` if the player hits a collision object within the
+	 *         movement, `false` otherwise.
+	 */
+	bool findFirstContact(const Point_2& playerPos, const Vector_2& playerMove,
+		double playerRadius, double& toi, Vector_2& normal) const;
+	/**
+	 * @brief Checks whether a player has collision with any collision object.
+	 * 
+	 * @param seg Current trajectory shape.
+	 * @param playerRadius Radius (size) of the player bubble.
+	 */
+	bool hasAnyCollision(const Segment_2& seg, double playerRadius) const;
 public:
 	StageObstacles(const std::vector<StageObstacle>& obstacles,
 		const Size2d& bounds);
+	/**
+	 * @brief Returns the distance field of the obstacles and the stage bounds.
+	 */
+	const DistanceField& getDistanceField() const;
 	/**
 	 * @brief Creates the player trajectory, taking the obstacles into account.
+	 * 
+	 * @details When the player hits an obstacle, the rest of the movement is
+	 *          projected onto the contact tangent, so the player slides along
+	 *          the obstacle (at most `MAX_SLIDE_ITERATIONS` times, then it
+	 *          stops at the contact). The trajectory is the line segment from
+	 *          the initial position to the final one.
 	 */
 	Trajectory getPlayerTrajectory(const Point_2& playerPos,
 		const Vector_2& playerMove, double playerRadius) const;
@@ -0,0 +1,240 @@
+/**
+ * @file TickProfiler.cpp
+ * @author Tomáš Ludrovan
+ * @brief TickProfiler class
+ * @version 0.1
+ * @date 2024-05-15
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "core/tickprofiler/TickProfiler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+/**
+ * @brief Returns the p-th percentile (nearest-rank method) of the values.
+ * 
+ * @details Reorders the values.
+ */
+static double percentile(std::vector<double>& values, double p)
+{
+	assert(!values.empty());
+
+	auto rank = static_cast<size_t>(std::ceil(p * values.size()));
+	size_t idx = (rank == 0 ? 0 : rank - 1);
+
+	std::nth_element(values.begin(), values.begin() + idx, values.end());
+	return values[idx];
+}
+
+TickProfiler::TickProfiler(std::clock_t deadline)
+	: m_deadline{static_cast<double>(deadline)}
+	, m_isEnabled{true}
+	, m_slowestPhase{PHASE_TICK}
+	, m_slowestDuration{-1.0}
+{
+	for (auto& data : m_phases) {
+		data.window.reserve(WINDOW_SIZE);
+	}
+
+	reset();
+}
+
+const char* TickProfiler::getPhaseName(Phase phase)
+{
+	switch (phase) {
+		case PHASE_JOIN_AGENTS: return "join-agents";
+		case PHASE_READ_INPUTS: return "read-inputs";
+		case PHASE_INIT_TURN_DATA: return "init-turn-data";
+		case PHASE_APPLY_PLAYER_EFFECTS: return "apply-player-effects";
+		case PHASE_CALCULATE_TRAJECTORIES: return "calculate-trajectories";
+		case PHASE_FIND_COLLISIONS: return "find-collisions";
+		case PHASE_UPDATE_PLAYERS_STATES: return "update-players-states";
+		case PHASE_CHECK_IS_GAME_OVER: return "check-is-game-over";
+		case PHASE_CLEAR_BONUSES: return "clear-bonuses";
+		case PHASE_GENERATE_BONUS: return "generate-bonus";
+		case PHASE_NOTIFY_AGENTS: return "notify-agents";
+		case PHASE_TICK: return "tick";
+		default: return "";
+	}
+}
+
+void TickProfiler::addSample(Phase phase, double ms)
+{
+	auto& data = m_phases[phase];
+
+	if (data.window.size() < WINDOW_SIZE) {
+		data.window.push_back(ms);
+	} else {
+		data.window[data.next] = ms;
+	}
+	data.next = (data.next + 1) % WINDOW_SIZE;
+
+	data.samples++;
+	data.peak = std::max(data.peak, ms);
+}
+
+void TickProfiler::setEnabled(bool isEnabled)
+{
+	m_isEnabled = isEnabled;
+}
+
+bool TickProfiler::isEnabled() const
+{
+	return m_isEnabled;
+}
+
+void TickProfiler::startTick()
+{
+	if (!m_isEnabled) return;
+
+	m_tickStart = Clock::now();
+	m_lapStart = m_tickStart;
+	m_slowestPhase = PHASE_TICK;
+	m_slowestDuration = -1.0;
+}
+
+void TickProfiler::lap(Phase phase)
+{
+	if (!m_isEnabled) return;
+
+	assert(phase != PHASE_TICK);
+
+	Clock::time_point now = Clock::now();
+	double ms = std::chrono::duration<double, std::milli>(now - m_lapStart)
+		.count();
+	m_lapStart = now;
+
+	addSample(phase, ms);
+
+	if (ms > m_slowestDuration) {
+		m_slowestPhase = phase;
+		m_slowestDuration = ms;
+	}
+}
+
+void TickProfiler::endTick()
+{
+	if (!m_isEnabled) return;
+
+	double ms = std::chrono::duration<double, std::milli>(
+		Clock::now() - m_tickStart).count();
+
+	addSample(PHASE_TICK, ms);
+
+	if (ms > m_deadline) {
+		m_deadlineMisses++;
+		m_phases[m_slowestPhase].blamed++;
+	}
+}
+
+TickProfiler::Stats TickProfiler::getStats(Phase phase) const
+{
+	const auto& data = m_phases[phase];
+
+	Stats res = {
+		data.samples, // samples
+		0.0, // mean
+		0.0, // p50
+		0.0, // p95
+		0.0, // p99
+		0.0, // max
+		data.peak, // peak
+		data.blamed, // blamed
+	};
+
+	if (data.window.empty()) {
+		return res;
+	}
+
+	// Copy, because the percentile calculation reorders the values
+	std::vector<double> values(data.window);
+
+	double sum = 0.0;
+	for (double v : values) {
+		sum += v;
+		res.max = std::max(res.max, v);
+	}
+	res.mean = sum / values.size();
+	res.p50 = percentile(values, 0.50);
+	res.p95 = percentile(values, 0.95);
+	res.p99 = percentile(values, 0.99);
+
+	return res;
+}
+
+TickProfiler::Phase TickProfiler::getLastSlowestPhase() const
+{
+	return (m_isEnabled ? m_slowestPhase : PHASE_TICK);
+}
+
+uint64_t TickProfiler::getDeadlineMisses() const
+{
+	return m_deadlineMisses;
+}
+
+void TickProfiler::merge(const TickProfiler& other)
+{
+	for (size_t i = 0; i < PHASE_COUNT; i++) {
+		auto phase = static_cast<Phase>(i);
+		const auto& otherData = other.m_phases[i];
+		auto& data = m_phases[i];
+
+		// Add the window of the other profiler, oldest sample first
+		size_t n = otherData.window.size();
+		size_t start = (n < WINDOW_SIZE ? 0 : otherData.next);
+		for (size_t j = 0; j < n; j++) {
+			addSample(phase, otherData.window[(start + j) % n]);
+		}
+
+		// `addSample()` counted only the samples in the window
+		data.samples += otherData.samples - n;
+		data.peak = std::max(data.peak, otherData.peak);
+		data.blamed += otherData.blamed;
+	}
+
+	m_deadlineMisses += other.m_deadlineMisses;
+}
+
+void TickProfiler::reset()
+{
+	for (auto& data : m_phases) {
+		data.window.clear();
+		data.next = 0;
+		data.samples = 0;
+		data.peak = 0.0;
+		data.blamed = 0;
+	}
+
+	m_deadlineMisses = 0;
+}
+
+void TickProfiler::writeCsv(std::ostream& os) const
+{
+	os << "phase,samples,mean_ms,p50_ms,p95_ms,p99_ms,max_ms,peak_ms,"
+		"deadline_misses\n";
+
+	for (size_t i = 0; i < PHASE_COUNT; i++) {
+		auto phase = static_cast<Phase>(i);
+		Stats stats = getStats(phase);
+
+		// The whole tick is blamed for all the missed deadlines
+		uint64_t misses = (phase == PHASE_TICK
+			? m_deadlineMisses
+			: stats.blamed);
+
+		os << getPhaseName(phase) << ","
+			<< stats.samples << ","
+			<< stats.mean << ","
+			<< stats.p50 << ","
+			<< stats.p95 << ","
+			<< stats.p99 << ","
+			<< stats.max << ","
+			<< stats.peak << ","
+			<< misses << "\n";
+	}
+}
@@ -0,0 +1,164 @@
+/**
+ * @file TickProfiler.hpp
+ * @author Tomáš Ludrovan
+ * @brief TickProfiler class
+ * @version 0.1
+ * @date 2024-05-15
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef TICKPROFILER_HPP
+#define TICKPROFILER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief Measures the duration of the individual phases of the game tick.
+ * 
+ * @details The last `WINDOW_SIZE` samples of each phase are kept, from which
+ *          the percentiles are calculated on demand. If the whole tick takes
+ *          longer than the deadline, the slowest phase of that tick is
+ *          "blamed" for it.
+ * 
+ *          Usage (once per tick):
+ *            startTick(); <phase A> lap(A); <phase B> lap(B); ... endTick();
+ */
+class TickProfiler {
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	enum Phase {
+		// Waiting for the agents planning in parallel
+		PHASE_JOIN_AGENTS,
+		PHASE_READ_INPUTS,
+		PHASE_INIT_TURN_DATA,
+		PHASE_APPLY_PLAYER_EFFECTS,
+		PHASE_CALCULATE_TRAJECTORIES,
+		PHASE_FIND_COLLISIONS,
+		PHASE_UPDATE_PLAYERS_STATES,
+		PHASE_CHECK_IS_GAME_OVER,
+		PHASE_CLEAR_BONUSES,
+		PHASE_GENERATE_BONUS,
+		PHASE_NOTIFY_AGENTS,
+		// The whole tick
+		PHASE_TICK,
+
+		PHASE_COUNT,
+	};
+
+	/**
+	 * @brief Statistics of a phase. All durations are in milliseconds.
+	 * 
+	 * @details The mean and the percentiles are calculated from the last
+	 *          `WINDOW_SIZE` samples.
+	 */
+	struct Stats {
+		// Total number of samples
+		uint64_t samples;
+		double mean;
+		double p50;
+		double p95;
+		double p99;
+		// Maximum in the window
+		double max;
+		// Maximum since the last reset
+		double peak;
+		// Number of missed deadlines in which this phase was the slowest one
+		uint64_t blamed;
+	};
+
+	// Number of the most recent samples kept for each phase
+	static constexpr size_t WINDOW_SIZE = 1024;
+private:
+	struct PhaseData {
+		// Ring buffer of durations (ms)
+		std::vector<double> window;
+		// Where the next sample will be written
+		size_t next;
+		uint64_t samples;
+		double peak;
+		uint64_t blamed;
+	};
+
+	std::array<PhaseData, PHASE_COUNT> m_phases;
+	double m_deadline;
+	bool m_isEnabled;
+	uint64_t m_deadlineMisses;
+
+	Clock::time_point m_tickStart;
+	Clock::time_point m_lapStart;
+	// Slowest phase of the current tick
+	Phase m_slowestPhase;
+	double m_slowestDuration;
+
+	void addSample(Phase phase, double ms);
+public:
+	/**
+	 * @brief Constructs a new TickProfiler object.
+	 * 
+	 * @param deadline Tick duration in milliseconds which counts as a missed
+	 *                 deadline if exceeded.
+	 */
+	TickProfiler(std::clock_t deadline);
+	/**
+	 * @brief Returns the name of the phase (as used in the CSV output).
+	 */
+	static const char* getPhaseName(Phase phase);
+
+	/**
+	 * @brief Enables or disables the measuring. Enabled by default.
+	 */
+	void setEnabled(bool isEnabled);
+	bool isEnabled() const;
+
+	/**
+	 * @brief Marks the beginning of a tick (and of its first phase).
+	 */
+	void startTick();
+	/**
+	 * @brief Marks the end of a phase and the beginning of the next one.
+	 */
+	void lap(Phase phase);
+	/**
+	 * @brief Marks the end of a tick.
+	 */
+	void endTick();
+
+	/**
+	 * @brief Returns the statistics of the phase.
+	 */
+	Stats getStats(Phase phase) const;
+	/**
+	 * @brief Returns the slowest phase of the last tick.
+	 * 
+	 * @details `PHASE_TICK` if the profiler is disabled.
+	 */
+	Phase getLastSlowestPhase() const;
+	/**
+	 * @brief Returns the number of ticks which took longer than the deadline.
+	 */
+	uint64_t getDeadlineMisses() const;
+	/**
+	 * @brief Adds the samples of another profiler to this one.
+	 * 
+	 * @details Useful for aggregating the results of several matches.
+	 */
+	void merge(const TickProfiler& other);
+	/**
+	 * @brief Removes all the samples.
+	 */
+	void reset();
+	/**
+	 * @brief Writes the statistics of all phases as CSV (with a header line).
+	 */
+	void writeCsv(std::ostream& os) const;
+};
+
+#endif // TICKPROFILER_HPP
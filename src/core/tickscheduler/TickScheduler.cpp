@@ -0,0 +1,120 @@
+/**
+ * @file TickScheduler.cpp
+ * @author Tomáš Ludrovan
+ * @brief TickScheduler class
+ * @version 0.1
+ * @date 2024-05-06
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "core/tickscheduler/TickScheduler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+TickScheduler::TickScheduler(std::clock_t interval, unsigned maxCatchUp)
+	: m_interval{std::chrono::milliseconds(interval)}
+	, m_maxCatchUp{maxCatchUp}
+{
+	assert(interval > 0);
+	assert(maxCatchUp >= 1);
+
+	reset();
+	resetMetrics();
+}
+
+void TickScheduler::updateMetrics(double lag, unsigned ticks,
+	unsigned droppedTicks)
+{
+	m_metrics.ticks += ticks;
+	m_metrics.droppedTicks += droppedTicks;
+
+	if (m_hasLag) {
+		double jitter = std::abs(lag - m_metrics.lag);
+		m_metrics.jitter += SMOOTHING_FACTOR * (jitter - m_metrics.jitter);
+		m_metrics.maxJitter = std::max(m_metrics.maxJitter, jitter);
+		m_metrics.avgLag += SMOOTHING_FACTOR * (lag - m_metrics.avgLag);
+	} else {
+		m_metrics.avgLag = lag;
+		m_hasLag = true;
+	}
+
+	m_metrics.lag = lag;
+	m_metrics.maxLag = std::max(m_metrics.maxLag, lag);
+}
+
+void TickScheduler::reset()
+{
+	m_nextTick = Clock::now() + m_interval;
+}
+
+unsigned TickScheduler::update()
+{
+	Clock::time_point now = Clock::now();
+
+	if (now < m_nextTick) {
+		// Not yet
+		return 0;
+	}
+
+	// How late the oldest pending tick is
+	Clock::duration late = now - m_nextTick;
+	// Number of pending ticks (including the oldest one)
+	auto pending = static_cast<uint64_t>(late / m_interval) + 1;
+
+	unsigned res = static_cast<unsigned>(
+		std::min<uint64_t>(pending, m_maxCatchUp));
+	auto dropped = static_cast<unsigned>(pending - res);
+
+	// Skip all the pending ticks, even the dropped ones
+	m_nextTick += m_interval * pending;
+
+	updateMetrics(
+		std::chrono::duration<double, std::milli>(late).count(), // lag
+		res, // ticks
+		dropped // droppedTicks
+	);
+
+	return res;
+}
+
+std::clock_t TickScheduler::getInterval() const
+{
+	return static_cast<std::clock_t>(
+		std::chrono::duration_cast<std::chrono::milliseconds>(m_interval)
+		.count());
+}
+
+unsigned TickScheduler::getMaxCatchUp() const
+{
+	return m_maxCatchUp;
+}
+
+void TickScheduler::setMaxCatchUp(unsigned maxCatchUp)
+{
+	assert(maxCatchUp >= 1);
+
+	m_maxCatchUp = maxCatchUp;
+}
+
+const TickScheduler::Metrics& TickScheduler::getMetrics() const
+{
+	return m_metrics;
+}
+
+void TickScheduler::resetMetrics()
+{
+	m_metrics = Metrics{
+		0, // ticks
+		0, // droppedTicks
+		0.0, // lag
+		0.0, // avgLag
+		0.0, // maxLag
+		0.0, // jitter
+		0.0, // maxJitter
+	};
+	m_hasLag = false;
+}
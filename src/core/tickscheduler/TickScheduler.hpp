@@ -0,0 +1,110 @@
+/**
+ * @file TickScheduler.hpp
+ * @author Tomáš Ludrovan
+ * @brief TickScheduler class
+ * @version 0.1
+ * @date 2024-05-06
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef TICKSCHEDULER_HPP
+#define TICKSCHEDULER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+
+/**
+ * @brief Fixed-timestep scheduler of the game ticks.
+ * 
+ * @details Accumulates the real (monotonic) time and tells how many ticks
+ *          should be executed to keep up with it. If the simulation falls
+ *          behind by more than `maxCatchUp` ticks (e.g., after a stall), the
+ *          excess ticks are dropped instead of being executed in a burst.
+ * 
+ *          Also collects metrics about the timing accuracy:
+ *            - lag: how late a tick is executed after its ideal time,
+ *            - jitter: how much the lag changes between consecutive updates.
+ */
+class TickScheduler {
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	struct Metrics {
+		// Number of ticks scheduled for execution
+		uint64_t ticks;
+		// Number of ticks dropped because of the catch-up limit
+		uint64_t droppedTicks;
+		// Lag of the last update (ms)
+		double lag;
+		// Exponentially smoothed lag (ms)
+		double avgLag;
+		// Maximum lag (ms)
+		double maxLag;
+		// Exponentially smoothed jitter (ms)
+		double jitter;
+		// Maximum jitter (ms)
+		double maxJitter;
+	};
+private:
+	// Weight of the new sample in the exponential smoothing
+	static constexpr double SMOOTHING_FACTOR = 1.0 / 16.0;
+
+	Clock::duration m_interval;
+	unsigned m_maxCatchUp;
+	// The ideal time of the next tick
+	Clock::time_point m_nextTick;
+	Metrics m_metrics;
+	// False if no lag has been measured yet (jitter cannot be calculated)
+	bool m_hasLag;
+
+	void updateMetrics(double lag, unsigned ticks, unsigned droppedTicks);
+public:
+	/**
+	 * @brief Constructs a new TickScheduler object.
+	 * 
+	 * @param interval Tick interval in milliseconds.
+	 * @param maxCatchUp Maximum number of ticks returned by one `update()`
+	 *                   call. Must be at least 1.
+	 */
+	TickScheduler(std::clock_t interval, unsigned maxCatchUp);
+	/**
+	 * @brief Starts scheduling from now. The first tick will be due after one
+	 *        interval.
+	 * 
+	 * @details Does not reset the metrics.
+	 */
+	void reset();
+	/**
+	 * @brief Returns the number of ticks which should be executed now.
+	 * 
+	 * @details The returned ticks are considered executed. Must be polled
+	 *          regularly (e.g., every event loop iteration).
+	 */
+	unsigned update();
+	/**
+	 * @brief Returns the tick interval in milliseconds.
+	 */
+	std::clock_t getInterval() const;
+	/**
+	 * @brief Returns the maximum number of ticks returned by `update()`.
+	 */
+	unsigned getMaxCatchUp() const;
+	/**
+	 * @brief Sets the maximum number of ticks returned by `update()`. Must be
+	 *        at least 1.
+	 */
+	void setMaxCatchUp(unsigned maxCatchUp);
+	/**
+	 * @brief Returns the timing metrics.
+	 */
+	const Metrics& getMetrics() const;
+	/**
+	 * @brief Resets the timing metrics.
+	 */
+	void resetMetrics();
+};
+
+#endif // TICKSCHEDULER_HPP
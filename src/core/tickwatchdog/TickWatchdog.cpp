@@ -0,0 +1,163 @@
+/**
+ * @file TickWatchdog.cpp
+ * @author Tomáš Ludrovan
+ * @brief TickWatchdog class
+ * @version 0.1
+ * @date 2024-05-22
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "core/tickwatchdog/TickWatchdog.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+TickWatchdog::TickWatchdog(std::clock_t budget,
+	const TickDegradationPolicy& policy, unsigned maxCatchUp)
+	: m_budget{static_cast<double>(budget)}
+	, m_policy{policy}
+	, m_maxCatchUp{maxCatchUp}
+	, m_logNext{0}
+	, m_overruns{0}
+	, m_skippedPlans{0}
+	, m_overloadTicks{0}
+{
+	m_log.reserve(LOG_SIZE);
+}
+
+void TickWatchdog::skipWorstAgent()
+{
+	size_t skipped = 0;
+	size_t worst = NO_AGENT;
+	for (size_t i = 0; i < m_agentCosts.size(); i++) {
+		if (m_agentSkipTicks[i] > 0) {
+			skipped++;
+		} else if (worst == NO_AGENT || m_agentCosts[i] > m_agentCosts[worst]) {
+			worst = i;
+		}
+	}
+
+	if (worst != NO_AGENT && skipped < m_policy.maxSkippedAgents) {
+		m_agentSkipTicks[worst] = m_policy.replanSkipTicks;
+	}
+}
+
+void TickWatchdog::setAgentCount(size_t count)
+{
+	m_agentCosts.assign(count, 0.0);
+	m_agentSkipTicks.assign(count, 0);
+	m_agentBlamed.assign(count, 0);
+}
+
+void TickWatchdog::startTick()
+{
+	m_tickStart = Clock::now();
+}
+
+bool TickWatchdog::shouldPlan(size_t agent)
+{
+	if (m_agentSkipTicks[agent] > 0) {
+		m_agentSkipTicks[agent]--;
+		m_skippedPlans++;
+		return false;
+	}
+	return true;
+}
+
+void TickWatchdog::endTick(uint64_t tick, const TickProfiler& profiler,
+	const std::vector<double>& planDurations)
+{
+	double ms = std::chrono::duration<double, std::milli>(
+		Clock::now() - m_tickStart).count();
+
+	assert(planDurations.size() == m_agentCosts.size());
+	for (size_t i = 0; i < planDurations.size(); i++) {
+		if (planDurations[i] > 0.0) {
+			m_agentCosts[i] += SMOOTHING_FACTOR
+				* (planDurations[i] - m_agentCosts[i]);
+		}
+	}
+
+	if (ms <= m_budget) {
+		if (m_overloadTicks > 0) {
+			m_overloadTicks--;
+		}
+		return;
+	}
+
+	// Overrun
+
+	m_overruns++;
+	m_overloadTicks = m_policy.recoveryTicks;
+
+	Overrun overrun = {
+		tick, // tick
+		ms, // duration
+		profiler.getLastSlowestPhase(), // phase
+		NO_AGENT, // agent
+		0.0, // agentDuration
+	};
+	for (size_t i = 0; i < planDurations.size(); i++) {
+		if (planDurations[i] > overrun.agentDuration) {
+			overrun.agent = i;
+			overrun.agentDuration = planDurations[i];
+		}
+	}
+	if (overrun.agent != NO_AGENT) {
+		m_agentBlamed[overrun.agent]++;
+	}
+
+	if (m_log.size() < LOG_SIZE) {
+		m_log.push_back(overrun);
+	} else {
+		m_log[m_logNext] = overrun;
+	}
+	m_logNext = (m_logNext + 1) % LOG_SIZE;
+
+	skipWorstAgent();
+}
+
+bool TickWatchdog::isOverloaded() const
+{
+	return m_overloadTicks > 0;
+}
+
+unsigned TickWatchdog::getMaxCatchUp() const
+{
+	if (isOverloaded() && m_policy.overloadMaxCatchUp > 0) {
+		return std::min(m_maxCatchUp, m_policy.overloadMaxCatchUp);
+	}
+	return m_maxCatchUp;
+}
+
+uint64_t TickWatchdog::getOverrunCount() const
+{
+	return m_overruns;
+}
+
+uint64_t TickWatchdog::getSkippedPlanCount() const
+{
+	return m_skippedPlans;
+}
+
+uint64_t TickWatchdog::getAgentBlamedCount(size_t agent) const
+{
+	assert(agent < m_agentBlamed.size());
+	return m_agentBlamed[agent];
+}
+
+std::vector<TickWatchdog::Overrun> TickWatchdog::getOverruns() const
+{
+	if (m_log.size() < LOG_SIZE) {
+		return m_log;
+	}
+
+	// Full ring buffer -- the oldest one is the next to be overwritten
+	std::vector<Overrun> res;
+	res.reserve(LOG_SIZE);
+	res.insert(res.end(), m_log.begin() + m_logNext, m_log.end());
+	res.insert(res.end(), m_log.begin(), m_log.begin() + m_logNext);
+	return res;
+}
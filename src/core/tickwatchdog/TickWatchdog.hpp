@@ -0,0 +1,165 @@
+/**
+ * @file TickWatchdog.hpp
+ * @author Tomáš Ludrovan
+ * @brief TickWatchdog class
+ * @version 0.1
+ * @date 2024-05-22
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef TICKWATCHDOG_HPP
+#define TICKWATCHDOG_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+#include "core/tickprofiler/TickProfiler.hpp"
+#include "gamesetupdata/GameSetupData.hpp"
+
+/**
+ * @brief Checks the duration of each tick against the tick budget and
+ *        degrades the game under load.
+ * 
+ * @details Every tick which takes longer than the budget is an overrun. The
+ *          overrun is recorded together with its culprits: the slowest phase
+ *          of the tick (according to the profiler) and the slowest agent of
+ *          the last finished planning.
+ * 
+ *          After an overrun, the watchdog applies the degradation policy:
+ *            - the most expensive agents skip replanning for a few ticks
+ *              (they keep the input of their last plan),
+ *            - the number of catch-up ticks is capped.
+ *          The core is overloaded until `recoveryTicks` ticks in a row fit
+ *          into the budget.
+ * 
+ *          Usage (once per tick):
+ *            startTick(); ...
+ *            for each agent: if (shouldPlan(i)) <plan>
+ *            ... endTick(tick, profiler, planDurations);
+ *          The planning may also finish after `endTick()` (then it is passed
+ *          to the next `endTick()`).
+ */
+class TickWatchdog {
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	// No agent is to blame
+	static constexpr size_t NO_AGENT = static_cast<size_t>(-1);
+	// Number of the most recent overruns kept
+	static constexpr size_t LOG_SIZE = 64;
+
+	struct Overrun {
+		uint64_t tick;
+		// Duration of the tick (ms)
+		double duration;
+		// Slowest phase of the tick (`PHASE_TICK` if unknown)
+		TickProfiler::Phase phase;
+		// Slowest agent of the tick (`NO_AGENT` if no agent planned)
+		size_t agent;
+		// Plan duration of `agent` (ms)
+		double agentDuration;
+	};
+private:
+	// Weight of the new sample in the exponential smoothing
+	static constexpr double SMOOTHING_FACTOR = 1.0 / 8.0;
+
+	double m_budget;
+	TickDegradationPolicy m_policy;
+	unsigned m_maxCatchUp;
+
+	Clock::time_point m_tickStart;
+
+	// Indexed by the agent index
+	// Exponentially smoothed plan duration (ms)
+	std::vector<double> m_agentCosts;
+	// Number of ticks the agent does not replan for
+	std::vector<unsigned> m_agentSkipTicks;
+	// Number of overruns in which the agent was the slowest one
+	std::vector<uint64_t> m_agentBlamed;
+
+	// Ring buffer of the overruns
+	std::vector<Overrun> m_log;
+	// Where the next overrun will be written
+	size_t m_logNext;
+
+	uint64_t m_overruns;
+	uint64_t m_skippedPlans;
+	// Number of ticks until the core is no longer overloaded
+	unsigned m_overloadTicks;
+
+	/**
+	 * @brief Makes the most expensive agent (which is not skipped yet) skip
+	 *        replanning.
+	 */
+	void skipWorstAgent();
+public:
+	/**
+	 * @brief Constructs a new TickWatchdog object.
+	 * 
+	 * @param budget Tick budget in milliseconds.
+	 * @param policy Degradation policy.
+	 * @param maxCatchUp Catch-up limit when not overloaded.
+	 */
+	TickWatchdog(std::clock_t budget, const TickDegradationPolicy& policy,
+		unsigned maxCatchUp);
+
+	/**
+	 * @brief Sets the number of agents (and resets their statistics).
+	 */
+	void setAgentCount(size_t count);
+
+	/**
+	 * @brief Marks the beginning of a tick.
+	 */
+	void startTick();
+	/**
+	 * @brief Checks whether the agent should replan in this tick.
+	 * 
+	 * @details Must be called exactly once per agent per planning.
+	 */
+	bool shouldPlan(size_t agent);
+	/**
+	 * @brief Marks the end of a tick.
+	 * 
+	 * @param tick Number of the tick.
+	 * @param profiler Profiler of the tick phases (ended already). Used for
+	 *                 finding the slowest phase, if enabled.
+	 * @param planDurations Durations of the last finished planning of each
+	 *                      agent (ms); zero if the agent did not plan.
+	 */
+	void endTick(uint64_t tick, const TickProfiler& profiler,
+		const std::vector<double>& planDurations);
+
+	/**
+	 * @brief Checks whether a recent tick has overrun the budget.
+	 */
+	bool isOverloaded() const;
+	/**
+	 * @brief Returns the maximum number of ticks to catch up with now.
+	 */
+	unsigned getMaxCatchUp() const;
+	/**
+	 * @brief Returns the number of ticks which have overrun the budget.
+	 */
+	uint64_t getOverrunCount() const;
+	/**
+	 * @brief Returns the number of agent plans skipped by the degradation.
+	 */
+	uint64_t getSkippedPlanCount() const;
+	/**
+	 * @brief Returns the number of overruns in which the agent was the
+	 *        slowest one.
+	 */
+	uint64_t getAgentBlamedCount(size_t agent) const;
+	/**
+	 * @brief Returns the most recent overruns (at most `LOG_SIZE`), the oldest
+	 *        first.
+	 */
+	std::vector<Overrun> getOverruns() const;
+};
+
+#endif // TICKWATCHDOG_HPP
@@ -44,6 +44,11 @@ public:
 
 	Point_2 end() const { return m_seg.target(); }
 
+	/**
+	 * @brief Returns the bounding box of the trajectory.
+	 */
+	CGAL::Bbox_2 bbox() const { return m_seg.bbox(); }
+
 	/**
 	 * @brief Calculates the minimum squared distance between 2 trajectories in time.
 	 * 
@@ -280,6 +285,21 @@ public:
 		return m_segments.back();
 	}
 
+	/**
+	 * @brief Returns the bounding box of the trajectory.
+	 * 
+	 * @details Every segment is either a line segment or a quadrant arc, both
+	 *          are monotonic in X and Y, so the bounding box of the endpoints
+	 *          is sufficient.
+	 */
+	CGAL::Bbox_2 bbox() const {
+		CGAL::Bbox_2 res;
+		for (const auto& seg : m_segments) {
+			res += seg.getPStart().bbox() + seg.getPEnd().bbox();
+		}
+		return res;
+	}
+
 	/**
 	 * @brief Calculates the minimum squared distance between 2 trajectories in time.
 	 * 
@@ -0,0 +1,166 @@
+/**
+ * @file WorkerPool.cpp
+ * @author Tomáš Ludrovan
+ * @brief WorkerPool class
+ * @version 0.1
+ * @date 2024-05-18
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "core/workerpool/WorkerPool.hpp"
+
+#include <cassert>
+
+WorkerPool::WorkerPool(size_t workerCount)
+	: m_jobGeneration{0}
+	, m_isQuitting{false}
+	, m_jobFunction{nullptr}
+	, m_jobCount{0}
+	, m_jobChunkCount{0}
+	, m_nextChunk{0}
+	, m_busyWorkers{0}
+	, m_isJobActive{false}
+{
+	m_workers.reserve(workerCount);
+	for (size_t i = 0; i < workerCount; i++) {
+		m_workers.emplace_back(&WorkerPool::workerMain, this);
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	wait();
+
+	{
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_isQuitting = true;
+	}
+	m_cvJob.notify_all();
+
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+}
+
+void WorkerPool::workerMain()
+{
+	uint64_t lastGeneration = 0;
+
+	while (true) {
+		// Wait for a new job
+		{
+			std::unique_lock<std::mutex> lk(m_mutex);
+			m_cvJob.wait(lk, [this, lastGeneration]() {
+				return m_isQuitting || m_jobGeneration != lastGeneration;
+			});
+			if (m_isQuitting) break;
+			lastGeneration = m_jobGeneration;
+		}
+
+		processChunks();
+
+		// Report
+		{
+			std::lock_guard<std::mutex> lk(m_mutex);
+			m_busyWorkers--;
+		}
+		m_cvDone.notify_one();
+	}
+}
+
+void WorkerPool::processChunks()
+{
+	while (true) {
+		size_t chunk = m_nextChunk.fetch_add(1, std::memory_order_relaxed);
+		if (chunk >= m_jobChunkCount) break;
+
+		size_t begin, end;
+		getChunkRange(m_jobCount, m_jobChunkCount, chunk, begin, end);
+		(*m_jobFunction)(chunk, begin, end);
+	}
+}
+
+size_t WorkerPool::getWorkerCount() const
+{
+	return m_workers.size();
+}
+
+void WorkerPool::getChunkRange(size_t count, size_t chunkCount, size_t chunk,
+	size_t& begin, size_t& end)
+{
+	assert(chunk < chunkCount);
+
+	// The first `count % chunkCount` chunks are one index longer
+	size_t base = count / chunkCount;
+	size_t rem = count % chunkCount;
+	begin = chunk * base + (chunk < rem ? chunk : rem);
+	end = begin + base + (chunk < rem ? 1 : 0);
+}
+
+void WorkerPool::run(size_t count, size_t chunkCount, const ChunkFunction& fn)
+{
+	assert(!m_isJobActive);
+
+	if (chunkCount == 0) return;
+
+	if (m_workers.empty() || chunkCount == 1) {
+		// Nothing to parallelize
+		for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+			size_t begin, end;
+			getChunkRange(count, chunkCount, chunk, begin, end);
+			fn(chunk, begin, end);
+		}
+		return;
+	}
+
+	start(count, chunkCount, fn);
+	wait();
+}
+
+void WorkerPool::runOptional(WorkerPool* workerPool, size_t count,
+	const ChunkFunction& fn)
+{
+	if (workerPool == nullptr) {
+		fn(0, 0, count);
+	} else {
+		workerPool->run(count, workerPool->getWorkerCount() + 1, fn);
+	}
+}
+
+void WorkerPool::start(size_t count, size_t chunkCount,
+	const ChunkFunction& fn)
+{
+	assert(!m_isJobActive);
+
+	if (chunkCount == 0) return;
+
+	// Publish the job
+	{
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_jobFunction = &fn;
+		m_jobCount = count;
+		m_jobChunkCount = chunkCount;
+		m_nextChunk.store(0, std::memory_order_relaxed);
+		m_busyWorkers = m_workers.size();
+		m_jobGeneration++;
+	}
+	m_cvJob.notify_all();
+
+	m_isJobActive = true;
+}
+
+void WorkerPool::wait()
+{
+	if (!m_isJobActive) return;
+
+	// Help
+	processChunks();
+
+	// Join
+	std::unique_lock<std::mutex> lk(m_mutex);
+	m_cvDone.wait(lk, [this]() { return m_busyWorkers == 0; });
+	m_jobFunction = nullptr;
+	m_isJobActive = false;
+}
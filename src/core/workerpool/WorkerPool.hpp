@@ -0,0 +1,135 @@
+/**
+ * @file WorkerPool.hpp
+ * @author Tomáš Ludrovan
+ * @brief WorkerPool class
+ * @version 0.1
+ * @date 2024-05-18
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of threads executing fork-join jobs.
+ * 
+ * @details A job splits a range of indexes to chunks, which are processed by
+ *          the workers and by the calling thread. The chunk boundaries depend
+ *          only on the range size and the number of chunks, so if every chunk
+ *          writes only its own results, the outcome does not depend on the
+ *          scheduling.
+ * 
+ *          A job is either run to completion by `run()`, or started by
+ *          `start()` and finished later by `wait()`, so the calling thread can
+ *          do something else in the meantime.
+ */
+class WorkerPool {
+public:
+	/**
+	 * @brief Processes the indexes `[begin, end)` of the chunk `chunk`.
+	 */
+	typedef std::function<void(size_t chunk, size_t begin, size_t end)>
+		ChunkFunction;
+private:
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_mutex;
+	// Notifies the workers about a new job (or about quitting)
+	std::condition_variable m_cvJob;
+	// Notifies the caller about the job being finished
+	std::condition_variable m_cvDone;
+	// Incremented with each job
+	uint64_t m_jobGeneration;
+	bool m_isQuitting;
+
+	// The current job
+	const ChunkFunction* m_jobFunction;
+	size_t m_jobCount;
+	size_t m_jobChunkCount;
+	std::atomic<size_t> m_nextChunk;
+	// Number of workers still working on the current job
+	size_t m_busyWorkers;
+	// Has a job been started and not waited for yet? (Accessed only by the
+	// calling thread.)
+	bool m_isJobActive;
+
+	void workerMain();
+	/**
+	 * @brief Processes the chunks of the current job until there are none
+	 *        left.
+	 */
+	void processChunks();
+public:
+	/**
+	 * @brief Starts the worker threads.
+	 * 
+	 * @param workerCount Number of the threads besides the calling one.
+	 */
+	WorkerPool(size_t workerCount);
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	/**
+	 * @brief Returns the number of the worker threads.
+	 */
+	size_t getWorkerCount() const;
+	/**
+	 * @brief Returns the index range of a chunk.
+	 * 
+	 * @param count Size of the whole range.
+	 * @param chunkCount Number of chunks the range is split to.
+	 * @param chunk Index of the chunk.
+	 */
+	static void getChunkRange(size_t count, size_t chunkCount, size_t chunk,
+		size_t& begin, size_t& end);
+	/**
+	 * @brief Calls `fn` for each of `chunkCount` chunks of `[0, count)` in
+	 *        parallel and waits until all of them are processed.
+	 * 
+	 * @note Must not be called from within a job nor while a started job is
+	 *       running.
+	 */
+	void run(size_t count, size_t chunkCount, const ChunkFunction& fn);
+	/**
+	 * @brief Calls `fn` for a chunk of `[0, count)` per thread of the pool and
+	 *        waits until all of them are processed.
+	 * 
+	 * @param workerPool The pool; if `nullptr`, `fn` is called for the whole
+	 *                   range by the calling thread.
+	 */
+	static void runOptional(WorkerPool* workerPool, size_t count,
+		const ChunkFunction& fn);
+	/**
+	 * @brief Starts processing `chunkCount` chunks of `[0, count)` by the
+	 *        workers and returns right away.
+	 * 
+	 * @details The job must be finished by `wait()`. `fn` must stay valid
+	 *          until then. Without workers, the chunks are processed by
+	 *          `wait()`.
+	 * 
+	 * @note Must not be called from within a job nor while a started job is
+	 *       running.
+	 */
+	void start(size_t count, size_t chunkCount, const ChunkFunction& fn);
+	/**
+	 * @brief Waits until the job started by `start()` is finished. The
+	 *        calling thread helps with the remaining chunks.
+	 * 
+	 * @details Does nothing if there is no such job.
+	 */
+	void wait();
+};
+
+#endif // WORKERPOOL_HPP
@@ -21,6 +21,10 @@
  * @brief Random number engine type.
  */
 typedef std::minstd_rand RNGineType;
+/**
+ * @brief Seed of the random number engine.
+ */
+typedef RNGineType::result_type RNGSeedType;
 
 /**
  * @brief Removes the last character from string treating it as UTF-8 string.
@@ -90,14 +94,4 @@ inline bool vectorHasDuplicates(const std::vector<T>& v)
 	return false;
 }
 
-/**
- * @brief Returns initialized random number engine.
- */
-inline RNGineType& getRNGine()
-{
-	// Seeded using non-deterministic random value using `std::random_device`
-	static RNGineType res(std::random_device{}());
-	return res;
-}
-
 #endif // FUNCTIONS_HPP
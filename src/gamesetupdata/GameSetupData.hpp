@@ -13,16 +13,75 @@
 #define GAMESETUPDATA_HPP
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "functions.hpp"
 #include "aiplayeragent/IAIPlayerAgent.hpp"
 #include "playerinput/IPlayerInput.hpp"
 #include "stageserializer/IStageSerializer.hpp"
 
+class ReplayReader;
+
+/**
+ * @brief Precision of the reported player attributes.
+ * 
+ * @details A change of an attribute is reported by a core event only if the
+ *          value moves to another multiple of the step (0 = every change is
+ *          reported).
+ */
+struct PlayerEventSteps {
+	double pos = 0.0;
+	double hp = 0.0;
+	double size = 0.0;
+};
+
+/**
+ * @brief How the core degrades when the ticks do not fit into the tick
+ *        interval (see `TickWatchdog`).
+ * 
+ * @details The defaults disable the degradation, so the match does not
+ *          depend on the speed of the machine.
+ */
+struct TickDegradationPolicy {
+	// Maximum number of agents which skip replanning at the same time
+	size_t maxSkippedAgents = 0;
+	// Number of ticks an agent skips replanning for
+	unsigned replanSkipTicks = 4;
+	// Maximum number of catch-up ticks while overloaded (0 = not capped)
+	unsigned overloadMaxCatchUp = 0;
+	// Number of ticks in a row within the interval after which the core is
+	// no longer overloaded
+	unsigned recoveryTicks = 60;
+};
+
 struct GameSetupData {
 	std::shared_ptr<IStageSerializer> stage;
 	std::vector<std::shared_ptr<IPlayerInput>> players;
 	std::vector<std::shared_ptr<IAIPlayerAgent>> aiAgents;
+	// Seed of all the randomness in the match (bonuses, AI agents). The same
+	// seed and the same player inputs result in the same match.
+	RNGSeedType seed = 0;
+	// ID of the loaded stage (needed for recording)
+	IStageSerializer::IdType stageId;
+	// If set, the recorded inputs are used instead of `players`
+	std::shared_ptr<ReplayReader> replay;
+	// If not empty, the match is recorded to this file
+	std::string recordPath;
+	// If set, the match continues unrecorded when the record file cannot be
+	// created (otherwise `Replay::Exception` is thrown)
+	bool isRecordingOptional = false;
+	// Number of worker threads the core uses to compute the ticks and to plan
+	// the AI agents besides its own thread (0 = no workers). Does not affect
+	// the outcome of the match.
+	size_t tickWorkerCount = 0;
+	// Time budget of a single planning of each AI agent (ms). If zero, the
+	// agents do a fixed amount of work per planning, so their decisions (and
+	// the outcome of the match) do not depend on the speed of the machine.
+	double agentPlanBudget = 0.0;
+	// Changes of the player attributes smaller than these are not reported
+	PlayerEventSteps playerEventSteps;
+	TickDegradationPolicy degradationPolicy;
 };
 
 #endif // GAMESETUPDATA_HPP
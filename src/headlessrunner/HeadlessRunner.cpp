@@ -0,0 +1,78 @@
+/**
+ * @file HeadlessRunner.cpp
+ * @author Tomáš Ludrovan
+ * @brief HeadlessRunner class
+ * @version 0.1
+ * @date 2024-05-02
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "headlessrunner/HeadlessRunner.hpp"
+
+#include "core/Core.hpp"
+#include "replay/ReplayReader.hpp"
+
+HeadlessRunner::HeadlessRunner(const GameSetupData& gsdata, size_t maxTicks)
+	: m_gsdata{gsdata}
+	, m_maxTicks{maxTicks}
+	, m_profiler(TICK_INTERVAL)
+	, m_watchdog(TICK_INTERVAL, gsdata.degradationPolicy, MAX_CATCH_UP_TICKS)
+{}
+
+HeadlessRunner::MatchResult HeadlessRunner::run()
+{
+	MatchResult res = {
+		false, // isDraw
+		false, // isTimeout
+		0, // winner
+		0, // ticks
+	};
+
+	Core core(m_gsdata);
+
+	// Initialize stage
+	core.step();
+
+	while (!core.isOver()) {
+		if (m_maxTicks != 0 && res.ticks >= m_maxTicks) {
+			res.isTimeout = true;
+			break;
+		}
+		if (m_gsdata.replay != nullptr && m_gsdata.replay->isFinished()) {
+			// The recorded match has been terminated before it ended
+			res.isTimeout = true;
+			break;
+		}
+
+		core.step();
+		res.ticks++;
+	}
+
+	if (core.isOver()) {
+		auto players = core.getPlayerStates();
+		if (players.empty()) {
+			res.isDraw = true;
+		} else {
+			res.winner = players.begin()->first;
+		}
+	}
+
+	m_profiler = core.getTickProfiler();
+	m_watchdog = core.getTickWatchdog();
+
+	core.quit();
+
+	return res;
+}
+
+const TickProfiler& HeadlessRunner::getProfiler() const
+{
+	return m_profiler;
+}
+
+const TickWatchdog& HeadlessRunner::getWatchdog() const
+{
+	return m_watchdog;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file HeadlessRunner.hpp
+ * @author Tomáš Ludrovan
+ * @brief HeadlessRunner class
+ * @version 0.1
+ * @date 2024-05-02
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef HEADLESSRUNNER_HPP
+#define HEADLESSRUNNER_HPP
+
+#include <cstddef>
+
+#include "core/Common.hpp"
+#include "core/tickprofiler/TickProfiler.hpp"
+#include "core/tickwatchdog/TickWatchdog.hpp"
+#include "gamesetupdata/GameSetupData.hpp"
+
+/**
+ * @brief Runs a single match without any graphical output.
+ * 
+ * @details The core ticks are executed back to back as fast as the CPU allows,
+ *          i.e. the simulated time is decoupled from the real time. Intended
+ *          for batch AI-vs-AI matches (balancing, regression testing).
+ */
+class HeadlessRunner {
+public:
+	struct MatchResult {
+		// True if no player survived
+		bool isDraw;
+		// True if the tick limit has been reached before the game ended
+		bool isTimeout;
+		// The winner (valid only if `!isDraw && !isTimeout`)
+		PlayerId winner;
+		// Number of ticks simulated
+		size_t ticks;
+	};
+private:
+	GameSetupData m_gsdata;
+	size_t m_maxTicks;
+	TickProfiler m_profiler;
+	TickWatchdog m_watchdog;
+public:
+	/**
+	 * @brief Constructs a new HeadlessRunner object.
+	 * 
+	 * @param gsdata Setup of the match. The player inputs and AI agents must
+	 *               not be shared with another match.
+	 * @param maxTicks Maximum number of ticks after which the match is
+	 *                 terminated. Zero means no limit.
+	 */
+	HeadlessRunner(const GameSetupData& gsdata, size_t maxTicks);
+	/**
+	 * @brief Runs the match until it is over or until the tick limit is
+	 *        reached.
+	 * 
+	 * @details If the match is a replay, it is also stopped at the end of the
+	 *          replay (reported as a timeout).
+	 */
+	MatchResult run();
+	/**
+	 * @brief Returns the tick profile of the last match run.
+	 */
+	const TickProfiler& getProfiler() const;
+	/**
+	 * @brief Returns the tick budget watchdog of the last match run.
+	 */
+	const TickWatchdog& getWatchdog() const;
+};
+
+#endif // HEADLESSRUNNER_HPP
@@ -0,0 +1,422 @@
+/**
+ * @file main_headless.cpp
+ * @author Tomáš Ludrovan
+ * @brief Headless match driver
+ * @version 0.1
+ * @date 2024-05-02
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ * @details Runs AI-vs-AI matches without any graphical output, as fast as
+ *          possible.
+ * 
+ *          Usage:
+ *            BUBLRAWL_headless [-n MATCHES] [-t MAX_TICKS] [-s SEED]
+ *              [-w REPLAY] [-p PROFILE_CSV] [-j WORKERS] [-P PLAYERS]
+ *              [-d SKIPPED_AGENTS] [-a PLAN_MS] STAGE_ID AGENT...
+ *            BUBLRAWL_headless -r REPLAY [-p PROFILE_CSV] [-j WORKERS]
+ *            BUBLRAWL_headless -b COUNTS [-n MATCHES] [-t MAX_TICKS] [-s SEED]
+ *              [-j WORKERS] STAGE_ID AGENT...
+ * 
+ *          Match `i` is seeded with `SEED + i`, so a run with the same seed
+ *          replays the same matches. If no seed is given, a random one is
+ *          chosen (and printed).
+ * 
+ *          `-w` records the matches (match `i` to "REPLAY.i" if there is more
+ *          than one). `-r` plays a recorded match back at maximum speed.
+ * 
+ *          `-j` computes the ticks with the given number of worker threads
+ *          (besides the main one). The results are the same as without it.
+ * 
+ *          `-P` sets the number of players (the agents are repeated in the
+ *          given order). The players the stage has no position for are
+ *          spawned in its free space.
+ * 
+ *          `-d` lets up to the given number of the most expensive agents skip
+ *          replanning for a few ticks after a tick overruns the tick
+ *          interval. The results then depend on the speed of the machine.
+ * 
+ *          `-a` gives each agent a time budget (ms) per planning instead of
+ *          a fixed amount of work. The results then depend on the speed of
+ *          the machine too.
+ * 
+ *          `-b` is the scaling benchmark: for each player count of the
+ *          comma-separated list, the matches are run and the duration of each
+ *          tick phase is printed (as CSV).
+ * 
+ *          Must be run from the directory containing the "stage/" directory.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "aiplayeragent/AIPlayerAgentFactory.hpp"
+#include "gamesetupdata/GameSetupData.hpp"
+#include "headlessrunner/HeadlessRunner.hpp"
+#include "playerinput/PlayerInputFactory.hpp"
+#include "replay/ReplayReader.hpp"
+#include "stageserializer/StageSerializerFactory.hpp"
+
+typedef std::shared_ptr<IAIPlayerAgent> (*AgentFactoryFn)(PlayerId);
+
+struct AgentEntry {
+	const char* name;
+	AgentFactoryFn create;
+};
+
+static const AgentEntry AGENTS[] = {
+	{"ladybug", &AIPlayerAgentFactory::createLadybugAIPlayerAgent},
+	{"blind-predator", &AIPlayerAgentFactory::createBlindPredatorAIPlayerAgent},
+	{"blind-prey", &AIPlayerAgentFactory::createBlindPreyAIPlayerAgent},
+	{"wall-aware-predator",
+		&AIPlayerAgentFactory::createWallAwarePredatorAIPlayerAgent},
+	{"wall-aware-prey", &AIPlayerAgentFactory::createWallAwarePreyAIPlayerAgent},
+	{"wall-aware-bfs-predator",
+		&AIPlayerAgentFactory::createWallAwareBFSPredatorAIPlayerAgent},
+	{"ids-predator", &AIPlayerAgentFactory::createIDSPredatorAIPlayerAgent},
+	{"bfs-predator", &AIPlayerAgentFactory::createBFSPredatorAIPlayerAgent},
+	{"astar-predator", &AIPlayerAgentFactory::createAstarPredatorAIPlayerAgent},
+	{"minimax-prey", &AIPlayerAgentFactory::createMinimaxPreyAIPlayerAgent},
+};
+
+static void printUsage(const char* prog)
+{
+	std::cerr << "Usage: " << prog
+		<< " [-n MATCHES] [-t MAX_TICKS] [-s SEED] [-w REPLAY] [-p PROFILE_CSV]"
+		<< " [-j WORKERS] [-P PLAYERS] [-d SKIPPED_AGENTS] [-a PLAN_MS]"
+		<< " STAGE_ID AGENT...\n"
+		<< "       " << prog << " -r REPLAY [-p PROFILE_CSV] [-j WORKERS]\n"
+		<< "       " << prog << " -b COUNTS [-n MATCHES] [-t MAX_TICKS]"
+		<< " [-s SEED] [-j WORKERS] STAGE_ID AGENT...\n"
+		<< "Agents:";
+	for (const auto& entry : AGENTS) {
+		std::cerr << " " << entry.name;
+	}
+	std::cerr << std::endl;
+}
+
+static const AgentEntry* findAgent(const std::string& name)
+{
+	for (const auto& entry : AGENTS) {
+		if (name == entry.name) return &entry;
+	}
+	return nullptr;
+}
+
+/**
+ * @brief Parses a comma-separated list of numbers.
+ */
+static std::vector<size_t> parseCounts(const std::string& str)
+{
+	std::vector<size_t> res;
+	std::stringstream ss(str);
+	std::string item;
+	while (std::getline(ss, item, ',')) {
+		res.push_back(std::strtoul(item.c_str(), nullptr, 10));
+	}
+	return res;
+}
+
+/**
+ * @brief Creates a fresh game setup (new agents and inputs) for one match.
+ * 
+ * @param playerCount Number of players; the agents are repeated.
+ */
+static GameSetupData createGameSetup(std::shared_ptr<IStageSerializer> stage,
+	const std::string& stageId, const std::vector<const AgentEntry*>& agents,
+	size_t playerCount, RNGSeedType seed)
+{
+	GameSetupData res;
+	res.stage = stage;
+	res.stageId = stageId;
+	res.seed = seed;
+
+	for (PlayerId id = 0; id < playerCount; id++) {
+		auto agent = agents[id % agents.size()]->create(id);
+		res.players.push_back(PlayerInputFactory::createAIPlayerInput(agent));
+		res.aiAgents.push_back(agent);
+	}
+
+	return res;
+}
+
+/**
+ * @brief Runs the scaling benchmark and prints the results (CSV).
+ */
+static void runScalingBenchmark(std::shared_ptr<IStageSerializer> stage,
+	const std::string& stageId, const std::vector<const AgentEntry*>& agents,
+	const std::vector<size_t>& playerCounts, size_t matchCount,
+	size_t maxTicks, RNGSeedType seed, size_t workerCount)
+{
+	std::cout << "players,phase,mean_ms,p50_ms,p99_ms,peak_ms,deadline_misses"
+		<< std::endl;
+
+	for (size_t playerCount : playerCounts) {
+		TickProfiler profiler(TICK_INTERVAL);
+
+		for (size_t match = 0; match < matchCount; match++) {
+			GameSetupData gsdata = createGameSetup(stage, stageId, agents,
+				playerCount, seed + static_cast<RNGSeedType>(match));
+			gsdata.tickWorkerCount = workerCount;
+
+			HeadlessRunner runner(gsdata, maxTicks);
+			runner.run();
+			profiler.merge(runner.getProfiler());
+		}
+
+		for (size_t i = 0; i < TickProfiler::PHASE_COUNT; i++) {
+			auto phase = static_cast<TickProfiler::Phase>(i);
+			auto stats = profiler.getStats(phase);
+
+			// The whole tick is blamed for all the missed deadlines
+			uint64_t misses = (phase == TickProfiler::PHASE_TICK
+				? profiler.getDeadlineMisses()
+				: stats.blamed);
+
+			std::cout << playerCount << ","
+				<< TickProfiler::getPhaseName(phase) << ","
+				<< stats.mean << ","
+				<< stats.p50 << ","
+				<< stats.p99 << ","
+				<< stats.peak << ","
+				<< misses << std::endl;
+		}
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	size_t matchCount = 1;
+	size_t maxTicks = 0;
+	RNGSeedType seed = std::random_device{}();
+	std::string recordPath;
+	std::string replayPath;
+	std::string profilePath;
+	size_t workerCount = 0;
+	size_t playerCount = 0;
+	size_t skippedAgentCount = 0;
+	double planBudget = 0.0;
+	std::vector<size_t> scalingCounts;
+	std::string stageId;
+	std::vector<const AgentEntry*> agents;
+
+	// Parse arguments
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+
+		if (arg == "-n" && i + 1 < argc) {
+			matchCount = std::strtoul(argv[++i], nullptr, 10);
+		} else if (arg == "-t" && i + 1 < argc) {
+			maxTicks = std::strtoul(argv[++i], nullptr, 10);
+		} else if (arg == "-s" && i + 1 < argc) {
+			seed = static_cast<RNGSeedType>(
+				std::strtoul(argv[++i], nullptr, 10));
+		} else if (arg == "-w" && i + 1 < argc) {
+			recordPath = argv[++i];
+		} else if (arg == "-r" && i + 1 < argc) {
+			replayPath = argv[++i];
+		} else if (arg == "-p" && i + 1 < argc) {
+			profilePath = argv[++i];
+		} else if (arg == "-j" && i + 1 < argc) {
+			workerCount = std::strtoul(argv[++i], nullptr, 10);
+		} else if (arg == "-P" && i + 1 < argc) {
+			playerCount = std::strtoul(argv[++i], nullptr, 10);
+		} else if (arg == "-d" && i + 1 < argc) {
+			skippedAgentCount = std::strtoul(argv[++i], nullptr, 10);
+		} else if (arg == "-a" && i + 1 < argc) {
+			planBudget = std::strtod(argv[++i], nullptr);
+		} else if (arg == "-b" && i + 1 < argc) {
+			scalingCounts = parseCounts(argv[++i]);
+		} else if (stageId.empty()) {
+			stageId = arg;
+		} else {
+			const AgentEntry* agent = findAgent(arg);
+			if (agent == nullptr) {
+				std::cerr << "Unknown agent: " << arg << std::endl;
+				printUsage(argv[0]);
+				return EXIT_FAILURE;
+			}
+			agents.push_back(agent);
+		}
+	}
+
+	// Names of the players (for the output)
+	std::vector<std::string> playerNames;
+	// Setup of the next match
+	std::function<GameSetupData(size_t)> createMatchSetup;
+
+	if (!replayPath.empty()) {
+		// Replay
+
+		if (!stageId.empty()) {
+			printUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+
+		GameSetupData replayGsdata;
+		try {
+			replayGsdata = ReplayReader::createGameSetup(
+				std::make_shared<ReplayReader>(replayPath));
+		} catch (const Replay::Exception& e) {
+			std::cerr << e.what() << std::endl;
+			return EXIT_FAILURE;
+		} catch (const IStageSerializer::Exception& e) {
+			std::cerr << e.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		matchCount = 1;
+		seed = replayGsdata.seed;
+		playerNames.assign(replayGsdata.players.size(), "replay");
+		createMatchSetup = [replayGsdata](size_t match) {
+			(void)match;
+			return replayGsdata;
+		};
+	} else {
+		// New matches
+
+		if (playerCount == 0) {
+			playerCount = agents.size();
+		}
+
+		if (stageId.empty() || agents.empty()
+			|| (scalingCounts.empty() && playerCount < 2))
+		{
+			printUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+
+		// Load stage
+		auto stage = StageSerializerFactory::createDefault();
+		try {
+			stage->load(stageId);
+		} catch (const IStageSerializer::Exception& e) {
+			std::cerr << e.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		if (!scalingCounts.empty()) {
+			runScalingBenchmark(stage, stageId, agents, scalingCounts,
+				matchCount, maxTicks, seed, workerCount);
+			return EXIT_SUCCESS;
+		}
+
+		for (PlayerId id = 0; id < playerCount; id++) {
+			playerNames.push_back(agents[id % agents.size()]->name);
+		}
+		createMatchSetup = [=](size_t match) {
+			GameSetupData res = createGameSetup(stage, stageId, agents,
+				playerCount, seed + static_cast<RNGSeedType>(match));
+			if (!recordPath.empty()) {
+				res.recordPath = (matchCount == 1
+					? recordPath
+					: recordPath + "." + std::to_string(match));
+			}
+			return res;
+		};
+	}
+
+	// Run
+	std::vector<size_t> wins(playerNames.size(), 0);
+	size_t draws = 0;
+	size_t timeouts = 0;
+	size_t totalTicks = 0;
+	TickProfiler profiler(TICK_INTERVAL);
+	uint64_t overruns = 0;
+	uint64_t skippedPlans = 0;
+	// Number of overruns each player's agent was the slowest in
+	std::vector<uint64_t> agentBlamed(playerNames.size(), 0);
+
+	auto tStart = std::chrono::steady_clock::now();
+
+	for (size_t match = 0; match < matchCount; match++) {
+		GameSetupData gsdata = createMatchSetup(match);
+		gsdata.tickWorkerCount = workerCount;
+		gsdata.degradationPolicy.maxSkippedAgents = skippedAgentCount;
+		gsdata.agentPlanBudget = planBudget;
+
+		HeadlessRunner runner(gsdata, maxTicks);
+		HeadlessRunner::MatchResult result;
+		try {
+			result = runner.run();
+		} catch (const Replay::Exception& e) {
+			std::cerr << e.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		totalTicks += result.ticks;
+		profiler.merge(runner.getProfiler());
+
+		const auto& watchdog = runner.getWatchdog();
+		overruns += watchdog.getOverrunCount();
+		skippedPlans += watchdog.getSkippedPlanCount();
+		// The agents are created in the order of the players
+		for (size_t i = 0; i < gsdata.aiAgents.size(); i++) {
+			agentBlamed[i] += watchdog.getAgentBlamedCount(i);
+		}
+
+		std::cout << "match " << match << ": ";
+		if (result.isTimeout) {
+			timeouts++;
+			std::cout << "timeout";
+		} else if (result.isDraw) {
+			draws++;
+			std::cout << "draw";
+		} else {
+			wins[result.winner]++;
+			std::cout << "winner " << result.winner << " ("
+				<< playerNames[result.winner] << ")";
+		}
+		std::cout << ", " << result.ticks << " ticks" << std::endl;
+	}
+
+	auto tEnd = std::chrono::steady_clock::now();
+	double seconds = std::chrono::duration<double>(tEnd - tStart).count();
+
+	// Summary
+	std::cout << "---" << std::endl;
+	std::cout << "seed: " << seed << std::endl;
+	for (PlayerId id = 0; id < playerNames.size(); id++) {
+		std::cout << "player " << id << " (" << playerNames[id] << "): "
+			<< wins[id] << " wins" << std::endl;
+	}
+	std::cout << "draws: " << draws << ", timeouts: " << timeouts << std::endl;
+	std::cout << "ticks: " << totalTicks << " in " << seconds << " s ("
+		<< (seconds > 0.0 ? totalTicks / seconds : 0.0) << " ticks/s)"
+		<< std::endl;
+
+	auto tickStats = profiler.getStats(TickProfiler::PHASE_TICK);
+	std::cout << "tick time: p50 " << tickStats.p50 << " ms, p99 "
+		<< tickStats.p99 << " ms, peak " << tickStats.peak << " ms ("
+		<< profiler.getDeadlineMisses() << " missed deadlines)" << std::endl;
+
+	std::cout << "watchdog: " << overruns << " overruns, " << skippedPlans
+		<< " skipped plans";
+	auto worstAgent = std::max_element(agentBlamed.begin(), agentBlamed.end());
+	if (worstAgent != agentBlamed.end() && *worstAgent > 0) {
+		auto id = static_cast<PlayerId>(worstAgent - agentBlamed.begin());
+		std::cout << "; slowest agent: player " << id << " ("
+			<< playerNames[id] << "), " << *worstAgent << " overruns";
+	}
+	std::cout << std::endl;
+
+	if (!profilePath.empty()) {
+		std::ofstream csv(profilePath);
+		if (!csv) {
+			std::cerr << "Cannot write " << profilePath << std::endl;
+			return EXIT_FAILURE;
+		}
+		profiler.writeCsv(csv);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file ReplayCommon.hpp
+ * @author Tomáš Ludrovan
+ * @brief Definitions shared by the replay reader and writer
+ * @version 0.1
+ * @date 2024-05-16
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ * @details Replay file layout (all integers little-endian):
+ * 
+ *            magic        4 B   "BRPL"
+ *            version      1 B
+ *            playerCount  4 B
+ *            seed         8 B
+ *            stageIdLen   2 B
+ *            stageId      stageIdLen B
+ *            frames       until the end of file
+ * 
+ *          A frame contains the inputs of all players for one tick, packed to
+ *          `BITS_PER_PLAYER` bits per player (player 0 in the lowest bits),
+ *          rounded up to whole bytes.
+ */
+
+#ifndef REPLAYCOMMON_HPP
+#define REPLAYCOMMON_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "playerinput/PlayerInputFlags.hpp"
+
+namespace Replay {
+	constexpr char MAGIC[4] = {'B', 'R', 'P', 'L'};
+	constexpr uint8_t VERSION = 2;
+	// left, up, right, down, deflate
+	constexpr size_t BITS_PER_PLAYER = 5;
+
+	class Exception : public std::runtime_error {
+	public:
+		Exception(const std::string& message)
+			: std::runtime_error(message)
+		{}
+	};
+
+	/**
+	 * @brief Returns the size of a frame in bytes.
+	 */
+	inline size_t getFrameSize(size_t playerCount) {
+		return (playerCount * BITS_PER_PLAYER + 7) / 8;
+	}
+
+	/**
+	 * @brief Converts the input flags to `BITS_PER_PLAYER` bits.
+	 */
+	inline unsigned packInput(const PlayerInputFlags& input) {
+		return (input.left    ? (1u << 0) : 0u)
+			| (input.up      ? (1u << 1) : 0u)
+			| (input.right   ? (1u << 2) : 0u)
+			| (input.down    ? (1u << 3) : 0u)
+			| (input.deflate ? (1u << 4) : 0u);
+	}
+
+	/**
+	 * @brief Converts `BITS_PER_PLAYER` bits to the input flags.
+	 */
+	inline PlayerInputFlags unpackInput(unsigned bits) {
+		PlayerInputFlags res;
+		res.left    = bits & (1u << 0);
+		res.up      = bits & (1u << 1);
+		res.right   = bits & (1u << 2);
+		res.down    = bits & (1u << 3);
+		res.deflate = bits & (1u << 4);
+		return res;
+	}
+}
+
+#endif // REPLAYCOMMON_HPP
@@ -0,0 +1,140 @@
+/**
+ * @file ReplayReader.cpp
+ * @author Tomáš Ludrovan
+ * @brief ReplayReader class
+ * @version 0.1
+ * @date 2024-05-16
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "replay/ReplayReader.hpp"
+
+#include <algorithm>
+
+#include "gamesetupdata/GameSetupData.hpp"
+#include "playerinput/PlayerInputFactory.hpp"
+#include "stageserializer/StageSerializerFactory.hpp"
+
+/**
+ * @brief Reads a `size`-byte little-endian integer.
+ * 
+ * @throws Replay::Exception Unexpected end of file.
+ */
+static uint64_t readUint(std::istream& is, size_t size)
+{
+	uint64_t res = 0;
+	for (size_t i = 0; i < size; i++) {
+		int c = is.get();
+		if (c == std::char_traits<char>::eof()) {
+			throw Replay::Exception("Replay header is truncated");
+		}
+		res |= static_cast<uint64_t>(c & 0xff) << (8*i);
+	}
+	return res;
+}
+
+ReplayReader::ReplayReader(const std::string& path)
+	: m_stream(path, std::ios::binary)
+{
+	if (!m_stream) {
+		throw Replay::Exception("Could not open replay file " + path);
+	}
+
+	char magic[sizeof(Replay::MAGIC)];
+	m_stream.read(magic, sizeof(magic));
+	if (!m_stream || !std::equal(magic, magic + sizeof(magic), Replay::MAGIC)) {
+		throw Replay::Exception(path + " is not a replay file");
+	}
+	if (readUint(m_stream, 1) != Replay::VERSION) {
+		throw Replay::Exception(path + ": unsupported replay version");
+	}
+
+	m_playerCount = static_cast<size_t>(readUint(m_stream, 4));
+	m_seed = static_cast<RNGSeedType>(readUint(m_stream, 8));
+
+	auto stageIdLen = static_cast<size_t>(readUint(m_stream, 2));
+	m_stageId.resize(stageIdLen);
+	m_stream.read(m_stageId.data(), stageIdLen);
+	if (!m_stream) {
+		throw Replay::Exception("Replay header is truncated");
+	}
+
+	m_framesBegin = m_stream.tellg();
+	m_frame.resize(Replay::getFrameSize(m_playerCount));
+}
+
+GameSetupData ReplayReader::createGameSetup(
+	std::shared_ptr<ReplayReader> reader)
+{
+	GameSetupData res;
+	res.stage = StageSerializerFactory::createDefault();
+	res.stage->load(reader->getStageId());
+	res.stageId = reader->getStageId();
+	res.seed = reader->getSeed();
+
+	// The inputs are ignored; the recorded ones are used instead
+	for (size_t id = 0; id < reader->getPlayerCount(); id++) {
+		res.players.push_back(PlayerInputFactory::createImmobilePlayerInput());
+	}
+
+	res.replay = reader;
+
+	return res;
+}
+
+const std::string& ReplayReader::getStageId() const
+{
+	return m_stageId;
+}
+
+RNGSeedType ReplayReader::getSeed() const
+{
+	return m_seed;
+}
+
+size_t ReplayReader::getPlayerCount() const
+{
+	return m_playerCount;
+}
+
+bool ReplayReader::readTick(std::vector<PlayerInputFlags>& inputs)
+{
+	m_stream.read(reinterpret_cast<char*>(m_frame.data()), m_frame.size());
+	if (m_stream.gcount() != static_cast<std::streamsize>(m_frame.size())) {
+		// End of file (an incomplete frame is ignored)
+		return false;
+	}
+
+	inputs.resize(m_playerCount);
+
+	for (size_t id = 0; id < m_playerCount; id++) {
+		size_t bitPos = id * Replay::BITS_PER_PLAYER;
+
+		// The bits may span two bytes
+		unsigned bits = m_frame[bitPos / 8] >> (bitPos % 8);
+		if ((bitPos % 8) + Replay::BITS_PER_PLAYER > 8) {
+			bits |= static_cast<unsigned>(m_frame[bitPos / 8 + 1])
+				<< (8 - (bitPos % 8));
+		}
+
+		inputs[id] = Replay::unpackInput(
+			bits & ((1u << Replay::BITS_PER_PLAYER) - 1));
+	}
+
+	return true;
+}
+
+void ReplayReader::seekTick(uint64_t tick)
+{
+	// The frames have a fixed size
+	m_stream.clear();
+	m_stream.seekg(m_framesBegin
+		+ static_cast<std::streamoff>(tick * m_frame.size()));
+}
+
+bool ReplayReader::isFinished()
+{
+	return m_stream.peek() == std::char_traits<char>::eof();
+}
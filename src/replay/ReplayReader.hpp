@@ -0,0 +1,82 @@
+/**
+ * @file ReplayReader.hpp
+ * @author Tomáš Ludrovan
+ * @brief ReplayReader class
+ * @version 0.1
+ * @date 2024-05-16
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef REPLAYREADER_HPP
+#define REPLAYREADER_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "functions.hpp"
+#include "playerinput/PlayerInputFlags.hpp"
+#include "replay/ReplayCommon.hpp"
+
+struct GameSetupData;
+
+/**
+ * @brief Reads the player inputs of a match from a replay file.
+ */
+class ReplayReader {
+private:
+	std::ifstream m_stream;
+	std::string m_stageId;
+	RNGSeedType m_seed;
+	size_t m_playerCount;
+	// Position of the first frame in the file
+	std::streampos m_framesBegin;
+	// Reused between ticks
+	std::vector<uint8_t> m_frame;
+public:
+	/**
+	 * @brief Opens the replay file and reads its header.
+	 * 
+	 * @throws Replay::Exception The file cannot be read or is not a valid
+	 *                           replay.
+	 */
+	ReplayReader(const std::string& path);
+	/**
+	 * @brief Creates a setup which plays the replay back.
+	 * 
+	 * @details Loads the stage of the replay. The player inputs are replaced
+	 *          by the recorded ones, so there are no AI agents.
+	 * 
+	 * @throws IStageSerializer::Exception The stage cannot be loaded.
+	 */
+	static GameSetupData createGameSetup(std::shared_ptr<ReplayReader> reader);
+
+	const std::string& getStageId() const;
+	RNGSeedType getSeed() const;
+	size_t getPlayerCount() const;
+
+	/**
+	 * @brief Reads the inputs of the next tick.
+	 * 
+	 * @param inputs Inputs indexed by player ID. Resized to the player count.
+	 * @return False if there are no more ticks (`inputs` are left unchanged).
+	 */
+	bool readTick(std::vector<PlayerInputFlags>& inputs);
+	/**
+	 * @brief Moves to the given tick, so the next `readTick()` call reads its
+	 *        inputs.
+	 * 
+	 * @param tick Number of the tick (the first one is 0).
+	 */
+	void seekTick(uint64_t tick);
+	/**
+	 * @brief Checks whether all the ticks have been read.
+	 */
+	bool isFinished();
+};
+
+#endif // REPLAYREADER_HPP
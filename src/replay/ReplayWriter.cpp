@@ -0,0 +1,95 @@
+/**
+ * @file ReplayWriter.cpp
+ * @author Tomáš Ludrovan
+ * @brief ReplayWriter class
+ * @version 0.1
+ * @date 2024-05-16
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include "replay/ReplayWriter.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <limits>
+
+/**
+ * @brief Writes `size` lowest bytes of `value` (little-endian).
+ */
+static void writeUint(std::ostream& os, uint64_t value, size_t size)
+{
+	for (size_t i = 0; i < size; i++) {
+		os.put(static_cast<char>((value >> (8*i)) & 0xff));
+	}
+}
+
+ReplayWriter::ReplayWriter(const std::string& path, const std::string& stageId,
+	RNGSeedType seed, size_t playerCount)
+	: m_path{path}
+	, m_stream(path, std::ios::binary | std::ios::trunc)
+	, m_playerCount{playerCount}
+	, m_frame(Replay::getFrameSize(playerCount))
+{
+	if (!m_stream) {
+		throw Replay::Exception("Could not create replay file " + path);
+	}
+	if (playerCount > std::numeric_limits<uint32_t>::max()
+		|| stageId.size() > std::numeric_limits<uint16_t>::max())
+	{
+		throw Replay::Exception("Match cannot be recorded");
+	}
+
+	m_stream.write(Replay::MAGIC, sizeof(Replay::MAGIC));
+	writeUint(m_stream, Replay::VERSION, 1);
+	writeUint(m_stream, playerCount, 4);
+	writeUint(m_stream, seed, 8);
+	writeUint(m_stream, stageId.size(), 2);
+	m_stream.write(stageId.data(), stageId.size());
+
+	m_framesBegin = m_stream.tellp();
+}
+
+void ReplayWriter::writeTick(const std::vector<PlayerInputFlags>& inputs)
+{
+	assert(inputs.size() == m_playerCount);
+
+	std::fill(m_frame.begin(), m_frame.end(), 0);
+
+	for (size_t id = 0; id < m_playerCount; id++) {
+		unsigned bits = Replay::packInput(inputs[id]);
+		size_t bitPos = id * Replay::BITS_PER_PLAYER;
+
+		// The bits may span two bytes
+		m_frame[bitPos / 8] |= static_cast<uint8_t>(bits << (bitPos % 8));
+		if ((bitPos % 8) + Replay::BITS_PER_PLAYER > 8) {
+			m_frame[bitPos / 8 + 1] |=
+				static_cast<uint8_t>(bits >> (8 - (bitPos % 8)));
+		}
+	}
+
+	m_stream.write(reinterpret_cast<const char*>(m_frame.data()),
+		m_frame.size());
+}
+
+void ReplayWriter::truncate(uint64_t tickCount)
+{
+	auto newSize = m_framesBegin
+		+ static_cast<std::streamoff>(tickCount * m_frame.size());
+
+	// Only rewinding is possible
+	assert(newSize <= m_stream.tellp());
+
+	m_stream.flush();
+
+	std::error_code ec;
+	std::filesystem::resize_file(m_path,
+		static_cast<std::uintmax_t>(std::streamoff(newSize)), ec);
+	if (ec) {
+		throw Replay::Exception("Could not truncate replay file " + m_path);
+	}
+
+	m_stream.seekp(newSize);
+}
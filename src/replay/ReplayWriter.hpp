@@ -0,0 +1,66 @@
+/**
+ * @file ReplayWriter.hpp
+ * @author Tomáš Ludrovan
+ * @brief ReplayWriter class
+ * @version 0.1
+ * @date 2024-05-16
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#ifndef REPLAYWRITER_HPP
+#define REPLAYWRITER_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "functions.hpp"
+#include "playerinput/PlayerInputFlags.hpp"
+#include "replay/ReplayCommon.hpp"
+
+/**
+ * @brief Records the player inputs of a match to a replay file.
+ */
+class ReplayWriter {
+private:
+	std::string m_path;
+	std::ofstream m_stream;
+	size_t m_playerCount;
+	// Position of the first frame in the file
+	std::streampos m_framesBegin;
+	// Reused between ticks
+	std::vector<uint8_t> m_frame;
+public:
+	/**
+	 * @brief Creates the replay file and writes its header.
+	 * 
+	 * @param path Path to the file. Overwritten if it exists.
+	 * @param stageId ID of the stage the match is played on.
+	 * @param seed Seed of the match.
+	 * @param playerCount Number of players (including the dead ones).
+	 * 
+	 * @throws Replay::Exception The file cannot be written.
+	 */
+	ReplayWriter(const std::string& path, const std::string& stageId,
+		RNGSeedType seed, size_t playerCount);
+	/**
+	 * @brief Appends the inputs of one tick.
+	 * 
+	 * @param inputs Inputs indexed by player ID.
+	 */
+	void writeTick(const std::vector<PlayerInputFlags>& inputs);
+	/**
+	 * @brief Discards the recorded ticks following the first `tickCount` ones.
+	 * 
+	 * @details Used when the match is rewound, so the recording only contains
+	 *          the ticks that have actually been played.
+	 * 
+	 * @throws Replay::Exception The file cannot be truncated.
+	 */
+	void truncate(uint64_t tickCount);
+};
+
+#endif // REPLAYWRITER_HPP
@@ -14,6 +14,7 @@
 
 #include <array>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <ctime>
 #include <vector>
@@ -1421,12 +1422,15 @@ struct Color {
  *          The timer's interval may not be modified. Instead, a new timer
  *          instance must be created.
  * 
- * @remark The timer may overflow.
+ *          Measures the wall time using a monotonic clock, so it is not
+ *          affected by the process load nor by system clock adjustments.
  */
 class Timer {
+public:
+	typedef std::chrono::steady_clock Clock;
 private:
-	std::clock_t m_interval;
-	std::clock_t m_nextTimestamp;
+	Clock::duration m_interval;
+	Clock::time_point m_nextTimestamp;
 public:
 	/**
 	 * @brief Construct a new Timer object.
@@ -1434,7 +1438,7 @@ public:
 	 * @param interval Timer interval in milliseconds.
 	 */
 	Timer(std::clock_t interval) :
-		m_interval{msToClocks(interval)}
+		m_interval{std::chrono::milliseconds(interval)}
 	{
 		reset();
 	}
@@ -1442,7 +1446,7 @@ public:
 	 * @brief Starts the timer again.
 	 */
 	void reset() {
-		m_nextTimestamp = std::clock() + m_interval;
+		m_nextTimestamp = Clock::now() + m_interval;
 	}
 	/**
 	 * @brief Checks whether the timer interval has elapsed.
@@ -1451,7 +1455,7 @@ public:
 	 *          won't be skipped.
 	 */
 	bool isLap() {
-		std::clock_t now = std::clock();
+		Clock::time_point now = Clock::now();
 		bool res = (now >= m_nextTimestamp);
 		if (res) {
 			m_nextTimestamp += m_interval;
@@ -1459,9 +1463,13 @@ public:
 		return res;
 	}
 	/**
-	 * @brief Returns the timer interval.
+	 * @brief Returns the timer interval in milliseconds.
 	 */
-	std::clock_t getInterval() const { return m_interval; }
+	std::clock_t getInterval() const {
+		return static_cast<std::clock_t>(
+			std::chrono::duration_cast<std::chrono::milliseconds>(m_interval)
+			.count());
+	}
 };
 
 /**